@@ -0,0 +1,272 @@
+#pragma once
+#include <string>
+#include <cstdint>
+#include <type_traits>
+#include <vector>
+#include <ctime>
+#include <iomanip>
+#include <sstream>
+
+#ifndef UNTITLED23_BINARYLOG_H
+#define UNTITLED23_BINARYLOG_H
+#endif
+/**
+ * @brief Бінарний формат структурованого логу (game_log.bin) — спільний для Logger і logdecode.
+ * @details Файл починається з заголовка "ZLOG" + байт версії, далі йдуть записи:
+ *  - 'S' — інтернований рядок: id, довжина, байти (ключі L10N та імена сутностей);
+ *  - 'E' — подія: дельта часу, рівень, id повідомлення, кількість аргументів, аргументи;
+ *  - 'T' — звичайне текстове повідомлення: дельта часу, рівень, довжина, байти.
+ * Числа записуються як LEB128 varint, знакові — через zigzag. Час — мікросекунди від епохи,
+ * кожен запис зберігає різницю з попереднім, тож зазвичай це 1-3 байти.
+ * Рядок завжди записується раніше за першу подію, що на нього посилається.
+ */
+namespace BinaryLog {
+    constexpr char MAGIC[4] = {'Z', 'L', 'O', 'G'};
+    constexpr uint8_t VERSION = 1;
+
+    constexpr uint8_t TAG_STRING = 'S';
+    constexpr uint8_t TAG_EVENT = 'E';
+    constexpr uint8_t TAG_TEXT = 'T';
+
+    /**
+     * @brief Тип аргументу події.
+     */
+    enum class ArgType : uint8_t {
+        Int = 0, ///< Ціле число
+        Str = 1  ///< Id інтернованого рядка
+    };
+
+    /**
+     * @brief Назва рівня для декодування (порядок як у LogLevel).
+     */
+    inline const char* levelName(uint8_t level) {
+        switch (level) {
+            case 0: return "INFO";
+            case 1: return "WARN";
+            case 2: return "ERROR";
+            case 3: return "DEBUG";
+        }
+        return "?";
+    }
+
+    /**
+     * @brief Підставляє аргументи у шаблон локалізації ("{0} takes {1} damage!").
+     * @details Номер — будь-яка кількість цифр ({10} теж), як у LanguageBundle::Builder.
+     * Заповнювач без відповідного аргументу лишається як є.
+     * @param argText Функція size_t -> std::string для n-го аргументу.
+     */
+    template<typename ArgText>
+    std::string fillTemplate(const std::string& f, size_t argc, ArgText&& argText) {
+        std::string text;
+        text.reserve(f.size() + 16);
+        for (size_t i = 0; i < f.size(); ++i) {
+            if (f[i] == '{') {
+                size_t close = i + 1;
+                size_t n = 0;
+                while (close < f.size() && f[close] >= '0' && f[close] <= '9' && n <= argc) {
+                    n = n * 10 + (size_t)(f[close] - '0');
+                    ++close;
+                }
+                if (close > i + 1 && close < f.size() && f[close] == '}' && n < argc) {
+                    text += argText(n);
+                    i = close;
+                    continue;
+                }
+            }
+            text += f[i];
+        }
+        return text;
+    }
+
+    /**
+     * @brief Локальний час "YYYY-MM-DD HH:MM:SS.мкс" для мітки в мікросекундах від епохи.
+     */
+    inline std::string formatTime(int64_t micros) {
+        std::time_t seconds = (std::time_t)(micros / 1000000);
+        std::tm tmBuf;
+#if defined(_WIN32) || defined(_WIN64)
+        localtime_s(&tmBuf, &seconds);
+#else
+        localtime_r(&seconds, &tmBuf);
+#endif
+        std::ostringstream ss;
+        ss << std::put_time(&tmBuf, "%Y-%m-%d %H:%M:%S") << '.' << std::setw(6) << std::setfill('0') << (micros % 1000000);
+        return ss.str();
+    }
+
+    inline uint64_t zigzag(int64_t v) { return ((uint64_t)v << 1) ^ (uint64_t)(v >> 63); }
+    inline int64_t unzigzag(uint64_t v) { return (int64_t)(v >> 1) ^ -(int64_t)(v & 1); }
+
+    inline void putVarint(std::string& out, uint64_t v) {
+        while (v >= 0x80) {
+            out += (char)(uint8_t)(v | 0x80);
+            v >>= 7;
+        }
+        out += (char)(uint8_t)v;
+    }
+
+    /**
+     * @brief Пише varint у сирий буфер (до 10 байтів) без виділення пам'яті.
+     * @return Позиція одразу за записаним числом.
+     */
+    inline uint8_t* putVarint(uint8_t* out, uint64_t v) {
+        while (v >= 0x80) {
+            *out++ = (uint8_t)(v | 0x80);
+            v >>= 7;
+        }
+        *out++ = (uint8_t)v;
+        return out;
+    }
+
+    /**
+     * @brief Читає varint.
+     * @return false, якщо дані закінчилися посеред числа.
+     */
+    inline bool getVarint(const uint8_t*& p, const uint8_t* end, uint64_t& v) {
+        v = 0;
+        for (int shift = 0; p < end && shift < 64; shift += 7) {
+            uint8_t byte = *p++;
+            v |= (uint64_t)(byte & 0x7F) << shift;
+            if (!(byte & 0x80)) return true;
+        }
+        return false;
+    }
+}
+
+/**
+ * @brief Посилання на інтернований рядок (див. Logger::intern) як аргумент події.
+ */
+struct LogStr {
+    uint32_t id;
+};
+
+/**
+ * @brief Аргумент структурованої події: ціле число або інтернований рядок.
+ */
+struct LogArg {
+    BinaryLog::ArgType type = BinaryLog::ArgType::Int;
+    int64_t value = 0;
+
+    LogArg() = default;
+    LogArg(LogStr s) : type(BinaryLog::ArgType::Str), value(s.id) {}
+
+    template<typename T, typename = std::enable_if_t<std::is_integral_v<T>>>
+    LogArg(T v) : type(BinaryLog::ArgType::Int), value((int64_t)v) {}
+};
+
+namespace BinaryLog {
+    /**
+     * @brief Розкодований запис логу (подія або текст).
+     */
+    struct Record {
+        uint8_t tag = TAG_TEXT;   ///< TAG_EVENT або TAG_TEXT
+        int64_t micros = 0;       ///< Мікросекунди від епохи
+        uint8_t level = 0;        ///< Значення LogLevel
+        uint32_t messageId = 0;   ///< Id ключа (для подій)
+        std::vector<LogArg> args; ///< Аргументи (для подій)
+        std::string text;         ///< Текст (для текстових записів)
+    };
+
+    /**
+     * @brief Послідовно читає записи з вмісту game_log.bin.
+     * @details Рядки ('S') запам'ятовує сам і не повертає; stringAt() розв'язує їхні id.
+     */
+    class Reader {
+        const uint8_t* p;
+        const uint8_t* end;
+        int64_t micros = 0;
+        std::vector<std::string> strings;
+        bool valid = true;
+
+        bool fail() {
+            valid = false;
+            return false;
+        }
+
+        bool getString(std::string& out) {
+            uint64_t len;
+            if (!getVarint(p, end, len) || (uint64_t)(end - p) < len) return false;
+            out.assign((const char*)p, (size_t)len);
+            p += len;
+            return true;
+        }
+
+        bool getTime() {
+            uint64_t delta;
+            if (!getVarint(p, end, delta)) return false;
+            micros += unzigzag(delta);
+            return true;
+        }
+
+    public:
+        /**
+         * @param data Увесь вміст файлу (має жити, доки працює Reader).
+         */
+        explicit Reader(const std::string& data)
+                : p((const uint8_t*)data.data()), end((const uint8_t*)data.data() + data.size()) {
+            if (data.size() < sizeof(MAGIC) + 1 || data.compare(0, sizeof(MAGIC), MAGIC, sizeof(MAGIC)) != 0 ||
+                (uint8_t)data[sizeof(MAGIC)] != VERSION) {
+                valid = false;
+                p = end;
+            } else {
+                p += sizeof(MAGIC) + 1;
+            }
+        }
+
+        /**
+         * @brief Читає наступну подію чи текст.
+         * @return false наприкінці файлу або якщо дані пошкоджені (див. isValid).
+         */
+        bool next(Record& record) {
+            while (p < end) {
+                uint8_t tag = *p++;
+                if (tag == TAG_STRING) {
+                    uint64_t id;
+                    std::string text;
+                    if (!getVarint(p, end, id) || id > UINT32_MAX || !getString(text)) return fail();
+                    if (strings.size() <= id) strings.resize((size_t)id + 1);
+                    strings[(size_t)id] = std::move(text);
+                    continue;
+                }
+
+                record = Record{};
+                record.tag = tag;
+                if (tag != TAG_EVENT && tag != TAG_TEXT) return fail();
+                if (!getTime() || p >= end) return fail();
+                record.micros = micros;
+                record.level = *p++;
+
+                if (tag == TAG_TEXT) {
+                    if (!getString(record.text)) return fail();
+                    return true;
+                }
+
+                uint64_t id;
+                if (!getVarint(p, end, id) || p >= end) return fail();
+                record.messageId = (uint32_t)id;
+                uint8_t argc = *p++;
+                for (uint8_t i = 0; i < argc; ++i) {
+                    uint64_t value;
+                    if (p >= end) return fail();
+                    LogArg arg;
+                    arg.type = (ArgType)*p++;
+                    if (!getVarint(p, end, value)) return fail();
+                    arg.value = unzigzag(value);
+                    record.args.push_back(arg);
+                }
+                return true;
+            }
+            return false;
+        }
+
+        /**
+         * @brief Інтернований рядок за id (або "?" для невідомого).
+         */
+        const std::string& stringAt(uint64_t id) const {
+            static const std::string unknown = "?";
+            return id < strings.size() ? strings[(size_t)id] : unknown;
+        }
+
+        bool isValid() const { return valid; }
+    };
+}
@@ -2,7 +2,6 @@
 #include <iostream>
 #include <string>
 #include "Zombie.h"
-#include "LocalizationManager.h"
 #include "Logger.h"
 
 using namespace std;
@@ -28,21 +27,16 @@ public:
      * @param sy Початкова координата Y.
      */
     Boss(const std::string& n, int h, int d, int r, int sx, int sy)
-            : Zombie(n, h, d, sx, sy), rage(r) {}
+            : Zombie(n, h, d, sx, sy, EntityKind::Boss), rage(r) {}
+
+    static bool isKind(EntityKind k) { return k == EntityKind::Boss; }
     /**
      * @brief Атака Боса.
      * @details Завдає шкоди цілі, що дорівнює (базова_шкода + лють).
      * @param target Сутність, яку атакує бос.
      */
     void attack(Entity& target) override {
-        int totalDamage = getDamage() + rage;
-
-        LOG_INFO(L10N.getString("boss_attack_header"));
-        LOG_INFO(L10N.getFormattedString("boss_attacks_target", getName(), getHealth(), target.getName(), target.getHealth()));
-
-        target.takeDamage(totalDamage);
-
-        LOG_INFO(L10N.getFormattedString("target_hp_remaining", target.getName(), target.getHealth()));
+        enemyAttack(kind, nameId, name, health, damage, rage, target);
     }
     /**
      * @brief Повертає символ для відображення на карті ('B').
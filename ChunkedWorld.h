@@ -0,0 +1,233 @@
+#pragma once
+#include <vector>
+#include <unordered_map>
+#include <algorithm>
+#include <cstdint>
+#include "TileGrid.h"
+#include "TileRandom.h"
+#include "Logger.h"
+
+using namespace std;
+
+#ifndef UNTITLED23_CHUNKEDWORLD_H
+#define UNTITLED23_CHUNKEDWORLD_H
+#endif
+/**
+ * @brief Великий світ, поділений на чанки 64x64, що генеруються при першому зверненні.
+ * @details Кожен тайл — чиста функція (seed, x, y), як у Map, тож чанк можна
+ * згенерувати будь-коли й у будь-якому порядку, і він збігатиметься з Map того ж
+ * розміру та зерна. Далекі незмінені чанки просто викидаються (їх завжди можна
+ * згенерувати знову), а змінені (підібрано предмет) пакуються у компактне сховище (RLE).
+ * Тож пам'ять пропорційна досліджуваній області, а не розміру світу.
+ */
+class ChunkedWorld {
+public:
+    static constexpr int CHUNK_SIZE = 64; ///< Сторона чанка у клітинках
+
+private:
+    /**
+     * @brief Завантажений чанк.
+     */
+    struct Chunk {
+        TileGrid tiles{CHUNK_SIZE, CHUNK_SIZE, TILE_FLOOR};
+        bool dirty = false; ///< Чанк змінено після генерації (наприклад, підібрано предмет)
+    };
+
+    int width, height; ///< Межі світу; по краю — стіни, як у Map
+    int wallPercent;
+    uint64_t seed;
+    unordered_map<int64_t, Chunk> loaded; ///< Чанки в пам'яті
+    unordered_map<int64_t, vector<uint8_t>> stored; ///< Вивантажені змінені чанки у форматі RLE
+
+    static int floorDiv(int v, int d) { return (v >= 0) ? v / d : -((-v + d - 1) / d); }
+
+    static int64_t key(int cx, int cy) {
+        return ((int64_t)cx << 32) | (uint32_t)cy;
+    }
+
+    static int keyX(int64_t k) { return (int)(k >> 32); }
+    static int keyY(int64_t k) { return (int)(uint32_t)k; }
+
+    void generate(Chunk& chunk, int cx, int cy) const {
+        for (int y = 0; y < CHUNK_SIZE; ++y) {
+            for (int x = 0; x < CHUNK_SIZE; ++x) {
+                chunk.tiles.set(x, y, generatedTile(cx * CHUNK_SIZE + x, cy * CHUNK_SIZE + y));
+            }
+        }
+    }
+
+    /**
+     * @brief Пакує тайли чанка в пари (довжина серії, тайл).
+     */
+    static vector<uint8_t> compress(const TileGrid& tiles) {
+        vector<uint8_t> out;
+        const uint8_t* data = tiles.data();
+        size_t count = (size_t)CHUNK_SIZE * CHUNK_SIZE;
+        for (size_t i = 0; i < count;) {
+            uint8_t value = data[i];
+            size_t run = 1;
+            while (i + run < count && data[i + run] == value && run < 255) ++run;
+            out.push_back((uint8_t)run);
+            out.push_back(value);
+            i += run;
+        }
+        return out;
+    }
+
+    static void decompress(const vector<uint8_t>& packed, TileGrid& tiles) {
+        int cell = 0;
+        for (size_t i = 0; i + 1 < packed.size(); i += 2) {
+            for (int r = 0; r < packed[i]; ++r, ++cell) {
+                tiles.set(cell % CHUNK_SIZE, cell / CHUNK_SIZE, packed[i + 1]);
+            }
+        }
+    }
+
+    /**
+     * @brief Один тайл зі стисненого чанка без розпаковування всього чанка.
+     */
+    static uint8_t packedAt(const vector<uint8_t>& packed, int x, int y) {
+        int cell = y * CHUNK_SIZE + x;
+        for (size_t i = 0; i + 1 < packed.size(); i += 2) {
+            if (cell < packed[i]) return packed[i + 1];
+            cell -= packed[i];
+        }
+        return TILE_FLOOR;
+    }
+
+    /**
+     * @brief Повертає чанк, за потреби генеруючи або розпаковуючи його.
+     */
+    Chunk& touch(int cx, int cy) {
+        int64_t k = key(cx, cy);
+        auto it = loaded.find(k);
+        if (it != loaded.end()) return it->second;
+
+        Chunk& chunk = loaded[k];
+        auto packed = stored.find(k);
+        if (packed != stored.end()) {
+            decompress(packed->second, chunk.tiles);
+            chunk.dirty = true;
+            stored.erase(packed);
+        } else {
+            generate(chunk, cx, cy);
+        }
+        return chunk;
+    }
+
+public:
+    /**
+     * @brief Створює світ без жодного чанка в пам'яті.
+     * @param w Ширина світу.
+     * @param h Висота світу.
+     * @param wallPercent Відсоток стін.
+     * @param seed Зерно генерації.
+     */
+    ChunkedWorld(int w, int h, int wallPercent, uint64_t seed)
+            : width(w), height(h), wallPercent(wallPercent), seed(seed) {}
+
+    int getWidth() const { return width; }
+    int getHeight() const { return height; }
+
+    bool inBounds(int x, int y) const { return x >= 0 && x < width && y >= 0 && y < height; }
+
+    /**
+     * @brief Тайл, який генератор дає клітинці (без урахування змін гравця).
+     * @details Поза межами світу — стіна.
+     */
+    uint8_t generatedTile(int x, int y) const {
+        if (!inBounds(x, y)) return TILE_WALL;
+        if (y == 0 || y == height - 1 || x == 0 || x == width - 1) return TILE_WALL;
+        return rollTile(TileRandom::percent(seed, x, y), wallPercent);
+    }
+
+    /**
+     * @brief Поточний тайл у світових координатах.
+     * @details Нічого не завантажує: незавантажений чанк читається зі сховища
+     * або просто генерується для однієї клітинки.
+     */
+    uint8_t tileAt(int x, int y) const {
+        if (!inBounds(x, y)) return TILE_WALL;
+        int cx = floorDiv(x, CHUNK_SIZE);
+        int cy = floorDiv(y, CHUNK_SIZE);
+        int64_t k = key(cx, cy);
+        auto it = loaded.find(k);
+        if (it != loaded.end()) return it->second.tiles.at(x - cx * CHUNK_SIZE, y - cy * CHUNK_SIZE);
+        auto packed = stored.find(k);
+        if (packed != stored.end()) return packedAt(packed->second, x - cx * CHUNK_SIZE, y - cy * CHUNK_SIZE);
+        return generatedTile(x, y);
+    }
+
+    /**
+     * @brief Змінює тайл і позначає чанк як змінений. Поза межами світу нічого не робить.
+     */
+    void setTile(int x, int y, uint8_t tile) {
+        if (!inBounds(x, y)) return;
+        int cx = floorDiv(x, CHUNK_SIZE);
+        int cy = floorDiv(y, CHUNK_SIZE);
+        Chunk& chunk = touch(cx, cy);
+        chunk.tiles.set(x - cx * CHUNK_SIZE, y - cy * CHUNK_SIZE, tile);
+        chunk.dirty = true;
+    }
+
+    /**
+     * @brief Копіює прямокутник світу з лівим верхнім кутом (x0, y0) у out (розміром з out).
+     * @details Чанки, яких торкається прямокутник, генеруються або розпаковуються.
+     */
+    void copyWindow(int x0, int y0, TileGrid& out) {
+        const int x1 = x0 + out.getWidth();
+        const int y1 = y0 + out.getHeight();
+        for (int cy = floorDiv(y0, CHUNK_SIZE); cy * CHUNK_SIZE < y1; ++cy) {
+            for (int cx = floorDiv(x0, CHUNK_SIZE); cx * CHUNK_SIZE < x1; ++cx) {
+                const Chunk& chunk = touch(cx, cy);
+                int fromX = max(x0, cx * CHUNK_SIZE);
+                int toX = min(x1, (cx + 1) * CHUNK_SIZE);
+                int fromY = max(y0, cy * CHUNK_SIZE);
+                int toY = min(y1, (cy + 1) * CHUNK_SIZE);
+                for (int y = fromY; y < toY; ++y) {
+                    auto src = chunk.tiles[y - cy * CHUNK_SIZE];
+                    copy(src.begin() + (fromX - cx * CHUNK_SIZE), src.begin() + (toX - cx * CHUNK_SIZE),
+                         out[y - y0].begin() + (fromX - x0));
+                }
+            }
+        }
+    }
+
+    /**
+     * @brief Вивантажує чанки, що не перетинають прямокутник [x0, x1) x [y0, y1).
+     * @details Незмінені чанки викидаються, змінені пакуються у сховище.
+     * @return Кількість вивантажених чанків.
+     */
+    size_t evictOutside(int x0, int y0, int x1, int y1) {
+        const int cx0 = floorDiv(x0, CHUNK_SIZE), cx1 = floorDiv(x1 - 1, CHUNK_SIZE);
+        const int cy0 = floorDiv(y0, CHUNK_SIZE), cy1 = floorDiv(y1 - 1, CHUNK_SIZE);
+        size_t evicted = 0;
+        for (auto it = loaded.begin(); it != loaded.end();) {
+            int cx = keyX(it->first);
+            int cy = keyY(it->first);
+            if (cx < cx0 || cx > cx1 || cy < cy0 || cy > cy1) {
+                if (it->second.dirty) stored[it->first] = compress(it->second.tiles);
+                it = loaded.erase(it);
+                ++evicted;
+            } else {
+                ++it;
+            }
+        }
+        if (evicted > 0) {
+            LOG_DEBUG("Evicted " + to_string(evicted) + " far chunks.");
+        }
+        return evicted;
+    }
+
+    size_t loadedChunkCount() const { return loaded.size(); }
+    size_t storedChunkCount() const { return stored.size(); }
+
+    /**
+     * @brief Приблизний обсяг пам'яті під тайли (завантажені + стиснені).
+     */
+    size_t memoryUsage() const {
+        size_t bytes = loaded.size() * (size_t)CHUNK_SIZE * CHUNK_SIZE;
+        for (const auto& entry : stored) bytes += entry.second.size();
+        return bytes;
+    }
+};
@@ -1,6 +1,8 @@
 #pragma once
 #include <vector>
 #include <memory> // Для unique_ptr
+#include <iterator>
+#include "SlotMap.h"
 using namespace std;
 
 #ifndef UNTITLED23_CONTAINER_H
@@ -11,13 +13,85 @@ using namespace std;
 /**
  * @brief Універсальний контейнер для зберігання об'єктів.
  * @tparam T Тип об'єктів, що зберігаються (зазвичай Entity або його спадкоємці).
- * @details Використовує std::vector та std::unique_ptr для автоматичного управління пам'яттю.
+ * @details Використовує std::unique_ptr для автоматичного управління пам'яттю.
+ * Елементи лежать щільно у SlotMap: до них можна звертатися за індексом (для циклів)
+ * або за стабільним дескриптором SlotHandle, який не ламається при видаленні інших.
  */
 template<typename T>
 class Container {
-    vector<std::unique_ptr<T>> items;///< Вектор розумних вказівників на об'єкти
+    SlotMap<std::unique_ptr<T>> items;///< Розумні вказівники на об'єкти + дескриптори
+
+    using Storage = typename vector<std::unique_ptr<T>>::const_iterator;
 
 public:
+    /**
+     * @brief Ітератор, що видає сирі вказівники T* прямо зі сховища.
+     */
+    class RawIterator {
+        Storage it;
+
+    public:
+        using iterator_category = forward_iterator_tag;
+        using value_type = T*;
+        using difference_type = ptrdiff_t;
+        using pointer = T* const*;
+        using reference = T*;
+
+        RawIterator() = default;
+        explicit RawIterator(Storage it) : it(it) {}
+
+        T* operator*() const { return it->get(); }
+        RawIterator& operator++() { ++it; return *this; }
+        RawIterator operator++(int) { RawIterator old = *this; ++it; return old; }
+        bool operator==(const RawIterator& other) const { return it == other.it; }
+    };
+
+    /**
+     * @brief Ітератор, що пропускає все, окрім об'єктів типу U, і видає U*.
+     * @tparam U Тип-нащадок T (наприклад, Zombie або Boss); нащадки U теж підходять.
+     * Фільтр — порівняння тегу EntityKind (U::isKind), без dynamic_cast.
+     */
+    template<typename U>
+    class TypedIterator {
+        Storage it;
+        Storage last;
+
+        void skip() {
+            while (it != last && !U::isKind((*it)->getKind())) ++it;
+        }
+
+    public:
+        using iterator_category = forward_iterator_tag;
+        using value_type = U*;
+        using difference_type = ptrdiff_t;
+        using pointer = U* const*;
+        using reference = U*;
+
+        TypedIterator() = default;
+        TypedIterator(Storage it, Storage last) : it(it), last(last) { skip(); }
+
+        U* operator*() const { return static_cast<U*>(it->get()); }
+        TypedIterator& operator++() { ++it; skip(); return *this; }
+        TypedIterator operator++(int) { TypedIterator old = *this; ++*this; return old; }
+        bool operator==(const TypedIterator& other) const { return it == other.it; }
+    };
+
+    /**
+     * @brief Невласний перегляд діапазону [first, last) — нічого не копіює і не виділяє.
+     * @details Дійсний, доки контейнер не змінено (add/remove/clear).
+     */
+    template<typename It>
+    class View {
+        It first;
+        It last;
+
+    public:
+        View(It first, It last) : first(first), last(last) {}
+        It begin() const { return first; }
+        It end() const { return last; }
+        bool empty() const { return first == last; }
+    };
+
     /**
      * @brief Додає новий об'єкт у контейнер.
      * @param item Унікальний вказівник на об'єкт.
@@ -42,10 +116,28 @@ public:
     }
 
 
-    void add(unique_ptr<T> item) {
-        items.push_back(move(item));
+    /**
+     * @brief Додає новий об'єкт у контейнер.
+     * @return Стабільний дескриптор об'єкта.
+     */
+    SlotHandle add(unique_ptr<T> item) {
+        return items.insert(move(item));
+    }
+
+    /**
+     * @brief Отримує об'єкт за дескриптором.
+     * @return Вказівник або nullptr, якщо об'єкт уже видалено.
+     */
+    T* get(SlotHandle handle) const {
+        const auto* ptr = items.get(handle);
+        return ptr ? ptr->get() : nullptr;
     }
 
+    /**
+     * @brief Дескриптор об'єкта, що зараз лежить за індексом.
+     */
+    SlotHandle handleAt(size_t index) const { return items.handleAt(index); }
+
     /**
      * @brief Отримує доступ до об'єкта за індексом.
      * @param index Індекс елемента.
@@ -58,9 +150,27 @@ public:
         return nullptr;
     }
 
+    /**
+     * @brief Перегляд усіх об'єктів як T* без виділення пам'яті.
+     * @details `for (auto* e : container.all())` — заміна getAllRaw() у гарячих циклах.
+     */
+    View<RawIterator> all() const {
+        return {RawIterator(items.begin()), RawIterator(items.end())};
+    }
+
+    /**
+     * @brief Перегляд лише об'єктів типу U (наприклад, "усі зомбі" чи "усі боси").
+     * @details `for (Zombie* z : container.ofType<Zombie>())` — без копій і без виділень.
+     */
+    template<typename U>
+    View<TypedIterator<U>> ofType() const {
+        return {TypedIterator<U>(items.begin(), items.end()), TypedIterator<U>(items.end(), items.end())};
+    }
+
     /**
      * @brief Отримує вектор "сирих" вказівників для ітерації.
-     * @details Корисно для циклів `for (auto* e : container.getAllRaw())`.
+     * @details Щоразу виділяє новий вектор; для циклів краще all() або ofType<U>().
+     * Лишається для коду, якому потрібна знімок-копія (наприклад, щоб змінювати контейнер під час обходу).
      * @return Вектор звичайних вказівників T*.
      */
     vector<T*> getAllRaw() const {
@@ -79,11 +189,19 @@ public:
 
     /**
      * @brief Видаляє об'єкт з контейнера за індексом.
+     * @details Працює за O(1): на місце видаленого переїжджає останній елемент,
+     * тож порядок елементів не зберігається. Дескриптори решти лишаються дійсними.
      * @param index Індекс елемента для видалення.
      */
     void remove(size_t index) {
-        if (index < items.size()) {
-            items.erase(items.begin() + index);
-        }
+        items.eraseAt(index);
+    }
+
+    /**
+     * @brief Видаляє об'єкт за дескриптором.
+     * @return false, якщо дескриптор уже недійсний.
+     */
+    bool remove(SlotHandle handle) {
+        return items.erase(handle);
     }
 };
\ No newline at end of file
@@ -0,0 +1,267 @@
+#pragma once
+#include <vector>
+#include <string>
+#include <span>
+#include <cstdint>
+#include <iterator>
+#include "Entity.h"
+#include "FlowField.h"
+#include "OccupancyGrid.h"
+#include "Logger.h"
+#include "SlotMap.h"
+
+using namespace std;
+
+#ifndef UNTITLED23_ENEMYSTORE_H
+#define UNTITLED23_ENEMYSTORE_H
+#endif
+
+/**
+ * @brief Тип ворога у сховищі EnemyStore — той самий тег, що й Entity::getKind().
+ * @details Використовуються значення Zombie і Boss (бос: до шкоди додається лють).
+ */
+using EnemyType = EntityKind;
+
+using EnemyHandle = SlotHandle; ///< Стабільне посилання на ворога між ходами
+
+/**
+ * @brief Сховище ворогів у форматі "структура масивів" (SoA).
+ * @details Замість вектора unique_ptr на поліморфні Zombie/Boss кожне поле ворога
+ * лежить в окремому суцільному масиві: x, y, здоров'я, шкода, лють, тип.
+ * Гарячі цикли (хід ворогів, атака гравця, рендер) читають лише потрібні масиви
+ * підряд, без dynamic_cast і без стрибків по купі. Імена — "холодні" дані, лежать окремо.
+ * Правила бою ті самі, що в Zombie і Boss: обидва використовують applyDamage і enemyAttack з Entity.h.
+ *
+ * Стовпці завжди щільні. Видалення — swap-and-pop за O(1) у всіх стовпцях одночасно,
+ * а SlotIndex дає кожному ворогу стабільний EnemyHandle з поколінням.
+ */
+class EnemyStore {
+public:
+    /**
+     * @brief Ітератор по індексах ворогів одного типу (пропускає решту).
+     */
+    class TypeIterator {
+        const EnemyType* types = nullptr;
+        size_t i = 0;
+        size_t count = 0;
+        EnemyType wanted = EnemyType::Zombie;
+
+        void skip() {
+            while (i < count && types[i] != wanted) ++i;
+        }
+
+    public:
+        using iterator_category = forward_iterator_tag;
+        using value_type = size_t;
+        using difference_type = ptrdiff_t;
+        using pointer = const size_t*;
+        using reference = size_t;
+
+        TypeIterator() = default;
+        TypeIterator(span<const EnemyType> column, size_t start, EnemyType wanted)
+                : types(column.data()), i(start), count(column.size()), wanted(wanted) { skip(); }
+
+        size_t operator*() const { return i; }
+        TypeIterator& operator++() { ++i; skip(); return *this; }
+        TypeIterator operator++(int) { TypeIterator old = *this; ++*this; return old; }
+        bool operator==(const TypeIterator& other) const { return i == other.i; }
+    };
+
+    /**
+     * @brief Невласний перегляд індексів ворогів одного типу.
+     * @details Дійсний, доки сховище не змінено (add/remove/clear).
+     */
+    class TypeView {
+        span<const EnemyType> column;
+        EnemyType wanted;
+
+    public:
+        TypeView(span<const EnemyType> column, EnemyType wanted) : column(column), wanted(wanted) {}
+        TypeIterator begin() const { return {column, 0, wanted}; }
+        TypeIterator end() const { return {column, column.size(), wanted}; }
+    };
+
+private:
+    vector<int> xs;
+    vector<int> ys;
+    vector<int> healths;
+    vector<int> damages;
+    vector<int> rages;
+    vector<EnemyType> types;
+    vector<string> names; ///< Імена потрібні лише для логів та UI
+    vector<uint32_t> nameIds; ///< Інтерновані імена для структурованого логу (NOT_INTERNED, доки не знадобились)
+    SlotIndex slots; ///< Дескриптори -> поточні індекси
+
+    template<typename V>
+    static void swapPop(vector<V>& column, size_t i) {
+        if (i != column.size() - 1) column[i] = std::move(column.back());
+        column.pop_back();
+    }
+
+public:
+    EnemyStore() = default;
+
+    /**
+     * @brief Додає ворога.
+     * @param type Тип ворога.
+     * @param name Ім'я.
+     * @param hp Початкове здоров'я.
+     * @param dmg Базова шкода.
+     * @param rage Лють (для зомбі 0).
+     * @param x Координата X.
+     * @param y Координата Y.
+     * @return Стабільний дескриптор нового ворога (він стає останнім за індексом).
+     */
+    EnemyHandle add(EnemyType type, const string& name, int hp, int dmg, int rage, int x, int y) {
+        xs.push_back(x);
+        ys.push_back(y);
+        healths.push_back(hp);
+        damages.push_back(dmg);
+        rages.push_back(rage);
+        types.push_back(type);
+        names.push_back(name);
+        nameIds.push_back(Logger::NOT_INTERNED);
+        return slots.insert();
+    }
+
+    /**
+     * @brief Видаляє ворога за індексом за O(1).
+     * @details На його місце переїжджає останній ворог, тож індекси не стабільні
+     * між видаленнями — для довгих посилань використовуйте EnemyHandle.
+     */
+    void remove(size_t i) {
+        if (i >= size()) return;
+        swapPop(xs, i);
+        swapPop(ys, i);
+        swapPop(healths, i);
+        swapPop(damages, i);
+        swapPop(rages, i);
+        swapPop(types, i);
+        swapPop(names, i);
+        swapPop(nameIds, i);
+        slots.eraseDense(i);
+    }
+
+    /**
+     * @brief Видаляє ворога за дескриптором.
+     * @return false, якщо ворога вже немає.
+     */
+    bool remove(EnemyHandle h) {
+        if (!slots.contains(h)) return false;
+        remove(slots.denseOf(h));
+        return true;
+    }
+
+    /**
+     * @brief Поточний індекс ворога за дескриптором.
+     * @return Індекс або npos, якщо ворога вже видалено.
+     */
+    size_t find(EnemyHandle h) const {
+        return slots.contains(h) ? slots.denseOf(h) : npos;
+    }
+
+    bool contains(EnemyHandle h) const { return slots.contains(h); }
+
+    /**
+     * @brief Дескриптор ворога, що зараз лежить за індексом.
+     */
+    EnemyHandle handleAt(size_t i) const { return slots.handleAt(i); }
+
+    /**
+     * @brief Індекс ворога за номером слота (як його зберігає OccupancyGrid) або npos.
+     */
+    size_t findBySlot(uint32_t slot) const { return find(slots.handleOfSlot(slot)); }
+
+    static constexpr size_t npos = SIZE_MAX;
+
+    void clear() {
+        xs.clear();
+        ys.clear();
+        healths.clear();
+        damages.clear();
+        rages.clear();
+        types.clear();
+        names.clear();
+        nameIds.clear();
+        slots.clear();
+    }
+
+    /**
+     * @brief Резервує місце під n ворогів (для великих орд).
+     */
+    void reserve(size_t n) {
+        xs.reserve(n);
+        ys.reserve(n);
+        healths.reserve(n);
+        damages.reserve(n);
+        rages.reserve(n);
+        types.reserve(n);
+        names.reserve(n);
+        nameIds.reserve(n);
+    }
+
+    size_t size() const { return xs.size(); }
+
+    // --- Прямий доступ до стовпців для гарячих циклів ---
+    span<const int> getXs() const { return xs; }
+    span<const int> getYs() const { return ys; }
+    span<const int> getHealths() const { return healths; }
+    span<const EnemyType> getTypes() const { return types; }
+
+    /**
+     * @brief Індекси всіх ворогів заданого типу: `for (size_t i : enemies.ofType(EnemyType::Boss))`.
+     * @details Нічого не виділяє: ітератор лише пробігає стовпець типів.
+     */
+    TypeView ofType(EnemyType type) const { return {types, type}; }
+
+    int getX(size_t i) const { return xs[i]; }
+    int getY(size_t i) const { return ys[i]; }
+    int getHealth(size_t i) const { return healths[i]; }
+    int getDamage(size_t i) const { return damages[i]; }
+    int getRage(size_t i) const { return rages[i]; }
+    EnemyType getType(size_t i) const { return types[i]; }
+    const string& getName(size_t i) const { return names[i]; }
+    bool isAlive(size_t i) const { return healths[i] > 0; }
+
+    /**
+     * @brief Зсуває всіх ворогів на (dx, dy) — коли зсувається вікно великої карти.
+     */
+    void translate(int dx, int dy) {
+        for (int& x : xs) x += dx;
+        for (int& y : ys) y += dy;
+    }
+
+    /**
+     * @brief Повна шкода атаки ворога (для боса — з урахуванням люті).
+     */
+    int getAttackDamage(size_t i) const { return enemyAttackDamage(damages[i], rages[i]); }
+
+    /**
+     * @brief Ворог отримує шкоду (аналог Entity::takeDamage).
+     */
+    void takeDamage(size_t i, int dmg) { applyDamage(healths[i], dmg, nameIds[i], names[i]); }
+
+    /**
+     * @brief Атака ворога по цілі (аналог Zombie::attack / Boss::attack).
+     */
+    void attack(size_t i, Entity& target) {
+        enemyAttack(types[i], nameIds[i], names[i], healths[i], damages[i], rages[i], target);
+    }
+
+    /**
+     * @brief Крок ворога униз по полю потоку з урахуванням зайнятих клітинок.
+     */
+    void moveTowards(size_t i, const FlowField& field, OccupancyGrid& occupancy) {
+        auto occupied = [&](int cx, int cy) { return occupancy.isOccupied(cx, cy); };
+
+        int nextX = xs[i];
+        int nextY = ys[i];
+        if (!field.nextStep(xs[i], ys[i], nextX, nextY, occupied)) {
+            LOG_DEBUG(names[i] + " has no free step towards the target.");
+            return;
+        }
+        occupancy.move(xs[i], ys[i], nextX, nextY);
+        xs[i] = nextX;
+        ys[i] = nextY;
+    }
+};
@@ -1,7 +1,7 @@
 #pragma once
 #include <iostream>
 #include <string>
-#include "LocalizationManager.h"
+#include <cstdint>
 #include "Logger.h"
 
 using namespace std;
@@ -9,6 +9,37 @@ using namespace std;
 #ifndef UNTITLED23_ENTITY_H
 #define UNTITLED23_ENTITY_H
 #endif
+/**
+ * @brief Конкретний вид сутності — однобайтовий тег замість RTTI.
+ * @details Перевірка виду — це порівняння байта, тож її можна робити в кожному кадрі
+ * і виносити за межі циклів. Той самий тег використовує EnemyStore для стовпця типів.
+ */
+enum class EntityKind : uint8_t {
+    Player, ///< Гравець
+    Zombie, ///< Звичайний зомбі
+    Boss    ///< Бос (різновид зомбі)
+};
+
+/**
+ * @brief Правило отримання шкоди: здоров'я зменшується, але не нижче нуля.
+ * @details Спільне для Entity::takeDamage і EnemyStore::takeDamage, щоб правила бою
+ * були записані один раз.
+ * @param health Здоров'я, яке змінюється.
+ * @param dmg Кількість одиниць шкоди.
+ * @param nameId Кеш інтернованого імені (див. Logger::internCached).
+ * @param name Ім'я.
+ */
+inline void applyDamage(int& health, int dmg, uint32_t& nameId, const string& name) {
+    LOG_EVENT(LogLevel::Info, "entity_takes_damage", LogStr{Logger::internCached(nameId, name)}, dmg);
+
+    health -= dmg;
+    if (health < 0) health = 0;
+
+    if (health == 0) {
+        LOG_INFO(name + " has died.");
+    }
+}
+
 /**
  * @brief Абстрактний базовий клас для всіх сутностей гри (Гравець, Зомбі).
  */
@@ -17,14 +48,17 @@ protected:
     string name; ///< Ім'я сутності
     int health; ///< Поточне здоров'я
     int damage; ///< Базова сила атаки
+    EntityKind kind; ///< Вид сутності (задає конструктор нащадка)
+    mutable uint32_t nameId = Logger::NOT_INTERNED; ///< Id імені для структурованого логу, інтернується при першому записі
 public:
     /**
      * @brief Конструктор сутності.
      * @param n Ім'я.
      * @param h Початкове здоров'я.
      * @param d Шкода.
+     * @param k Вид сутності.
      */
-    Entity(const string& n, int h, int d) : name(n), health(h), damage(d) {}
+    Entity(const string& n, int h, int d, EntityKind k) : name(n), health(h), damage(d), kind(k) {}
     virtual ~Entity() {}
     Entity();
     /**
@@ -40,19 +74,60 @@ public:
      * @brief Метод отримання шкоди.
      * @param dmg Кількість одиниць шкоди.
      */
-    void takeDamage(int dmg) {
-        LOG_INFO(L10N.getFormattedString("entity_takes_damage", name, dmg));
-
-        health -= dmg;
-        if (health < 0) health = 0;
-
-        if (health == 0) {
-            LOG_INFO(name + " has died.");
-        }
-    }
+    void takeDamage(int dmg) { applyDamage(health, dmg, nameId, name); }
 
     bool isAlive() const { return health > 0; }
     string getName() const { return name; }
     int getHealth() const { return health; }
     int getDamage() const { return damage; }
-};
\ No newline at end of file
+    EntityKind getKind() const { return kind; }
+    /**
+     * @brief Інтерноване ім'я для LOG_EVENT (інтернується при першому виклику).
+     */
+    uint32_t getNameId() const { return Logger::internCached(nameId, name); }
+};
+
+/**
+ * @brief Повна шкода атаки ворога: базова шкода плюс лють (у звичайного зомбі лють 0).
+ */
+inline int enemyAttackDamage(int damage, int rage) { return damage + rage; }
+
+/**
+ * @brief Правило атаки ворога по цілі, спільне для Zombie, Boss і EnemyStore.
+ * @param kind Вид нападника (Zombie або Boss) — від нього залежить запис у лозі.
+ * @param nameId Кеш інтернованого імені нападника.
+ * @param name Ім'я нападника.
+ * @param health Здоров'я нападника (для логу).
+ * @param damage Базова шкода.
+ * @param rage Лють.
+ * @param target Ціль атаки.
+ */
+inline void enemyAttack(EntityKind kind, uint32_t& nameId, const string& name, int health, int damage, int rage, Entity& target) {
+    if (kind == EntityKind::Boss) {
+        LOG_EVENT(LogLevel::Info, "boss_attack_header");
+        LOG_EVENT(LogLevel::Info, "boss_attacks_target", LogStr{Logger::internCached(nameId, name)}, health, LogStr{target.getNameId()}, target.getHealth());
+    } else {
+        LOG_EVENT(LogLevel::Info, "zombie_attack_header");
+        LOG_EVENT(LogLevel::Info, "zombie_bites_target", LogStr{Logger::internCached(nameId, name)}, health, LogStr{target.getNameId()}, target.getHealth());
+    }
+
+    target.takeDamage(enemyAttackDamage(damage, rage));
+
+    LOG_EVENT(LogLevel::Info, "target_hp_remaining", LogStr{target.getNameId()}, target.getHealth());
+}
+
+/**
+ * @brief Приведення за тегом замість dynamic_cast.
+ * @details U має надавати `static bool isKind(EntityKind)`, яка враховує і нащадків
+ * (наприклад, Zombie::isKind приймає і Boss).
+ * @return Вказівник на U або nullptr, якщо сутність іншого виду.
+ */
+template<typename U>
+U* entity_cast(Entity* e) {
+    return (e && U::isKind(e->getKind())) ? static_cast<U*>(e) : nullptr;
+}
+
+template<typename U>
+const U* entity_cast(const Entity* e) {
+    return (e && U::isKind(e->getKind())) ? static_cast<const U*>(e) : nullptr;
+}
\ No newline at end of file
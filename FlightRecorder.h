@@ -0,0 +1,170 @@
+#pragma once
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <vector>
+#include "BinaryLog.h"
+
+#ifndef UNTITLED23_FLIGHTRECORDER_H
+#define UNTITLED23_FLIGHTRECORDER_H
+#endif
+/**
+ * @brief "Бортовий самописець": кільце з останніх CAPACITY подій логу в пам'яті.
+ * @details Запис іде на потоці, що логує, ще до черги письменника, тож кільце
+ * заповнюється навіть коли файл і консоль вимкнені (LogFormat::Off) або письменник відстає.
+ * Запис без блокувань і без виділення пам'яті: номер комірки береться одним fetch_add,
+ * текст обрізається до TEXT_SIZE байтів. Кожна комірка має лічильник-печатку
+ * (непарний — запис триває), тож snapshot() пропускає комірки, які саме перезаписуються.
+ */
+class FlightRecorder {
+public:
+    static constexpr size_t CAPACITY = 1024; ///< Скільки останніх подій пам'ятати
+    static constexpr size_t TEXT_SIZE = 120; ///< Максимальна довжина збереженого тексту
+    static constexpr size_t MAX_ARGS = 6;
+
+    /**
+     * @brief Копія однієї події.
+     */
+    struct Entry {
+        uint64_t number = 0;     ///< Порядковий номер події від старту
+        uint8_t level = 0;       ///< Значення LogLevel
+        bool isEvent = false;    ///< Подія (messageId + args) чи текст
+        int64_t micros = 0;      ///< Мікросекунди від епохи
+        uint32_t messageId = 0;
+        uint8_t argc = 0;
+        LogArg args[MAX_ARGS];
+        uint8_t textLength = 0;
+        char text[TEXT_SIZE];
+    };
+
+private:
+    struct Cell {
+        std::atomic<uint64_t> seal{0}; ///< 2n+1 — запис n триває, 2n+2 — запис n готовий
+        Entry entry;
+    };
+
+    std::atomic<uint64_t> head{0};
+    std::vector<Cell> cells;
+
+    template<typename Fill>
+    void record(Fill&& fill) {
+        uint64_t n = head.fetch_add(1, std::memory_order_relaxed);
+        Cell& cell = cells[n % CAPACITY];
+        cell.seal.store(2 * n + 1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+        cell.entry.number = n;
+        cell.entry.micros = nowMicros();
+        fill(cell.entry);
+        cell.seal.store(2 * n + 2, std::memory_order_release);
+    }
+
+public:
+    /**
+     * @brief Мікросекунди від епохи (clock_gettime, тож можна й з обробника сигналу).
+     */
+    static int64_t nowMicros() {
+        return std::chrono::duration_cast<std::chrono::microseconds>(
+                std::chrono::system_clock::now().time_since_epoch()).count();
+    }
+
+    FlightRecorder() : cells(CAPACITY) {}
+
+    FlightRecorder(const FlightRecorder&) = delete;
+    FlightRecorder& operator=(const FlightRecorder&) = delete;
+
+    /**
+     * @brief Запам'ятовує текстове повідомлення (обрізане до TEXT_SIZE).
+     */
+    void recordText(uint8_t level, const std::string& message) {
+        record([&](Entry& e) {
+            e.level = level;
+            e.isEvent = false;
+            e.argc = 0;
+            e.textLength = (uint8_t)std::min(message.size(), TEXT_SIZE);
+            std::memcpy(e.text, message.data(), e.textLength);
+        });
+    }
+
+    /**
+     * @brief Запам'ятовує структуровану подію.
+     */
+    void recordEvent(uint8_t level, uint32_t messageId, const LogArg* args, uint8_t argc) {
+        record([&](Entry& e) {
+            e.level = level;
+            e.isEvent = true;
+            e.messageId = messageId;
+            e.argc = (uint8_t)std::min<size_t>(argc, MAX_ARGS);
+            for (uint8_t i = 0; i < e.argc; ++i) e.args[i] = args[i];
+            e.textLength = 0;
+        });
+    }
+
+    /**
+     * @brief Викликає visit(const Entry&) для останніх подій від найстарішої до найновішої.
+     * @details Без блокувань і без виділення пам'яті (копія комірки лежить на стеку),
+     * тож придатна для обробника сигналу. Комірки, що перезаписуються просто зараз, пропускаються.
+     */
+    template<typename Visit>
+    void forEachRecent(Visit&& visit) const {
+        uint64_t end = head.load(std::memory_order_acquire);
+        uint64_t begin = end > CAPACITY ? end - CAPACITY : 0;
+        for (uint64_t n = begin; n < end; ++n) {
+            const Cell& cell = cells[n % CAPACITY];
+            if (cell.seal.load(std::memory_order_acquire) != 2 * n + 2) continue;
+            Entry copy = cell.entry;
+            std::atomic_thread_fence(std::memory_order_acquire);
+            if (cell.seal.load(std::memory_order_relaxed) != 2 * n + 2) continue;
+            visit(copy);
+        }
+    }
+
+    /**
+     * @brief Копія останніх подій від найстарішої до найновішої.
+     */
+    std::vector<Entry> snapshot() const {
+        std::vector<Entry> result;
+        result.reserve(CAPACITY);
+        forEachRecent([&](const Entry& e) { result.push_back(e); });
+        return result;
+    }
+
+    static constexpr size_t MAX_RECORD_SIZE = 256; ///< Верхня межа encode() для одного запису
+    static_assert(1 + 10 + 1 + 5 + 1 + MAX_ARGS * 11 <= MAX_RECORD_SIZE, "event record may overflow");
+    static_assert(1 + 10 + 1 + 2 + TEXT_SIZE <= MAX_RECORD_SIZE, "text record may overflow");
+
+    /**
+     * @brief Кодує подію як запис 'E' або 'T' формату game_log.bin (див. BinaryLog.h).
+     * @details Пише в сирий буфер без виділення пам'яті — для аварійного дампу.
+     * @param lastMicros Час попереднього запису; оновлюється.
+     * @param out Буфер щонайменше на MAX_RECORD_SIZE байтів.
+     * @return Кількість записаних байтів.
+     */
+    static size_t encode(const Entry& e, int64_t& lastMicros, uint8_t* out) {
+        uint8_t* p = out;
+        *p++ = e.isEvent ? BinaryLog::TAG_EVENT : BinaryLog::TAG_TEXT;
+        p = BinaryLog::putVarint(p, BinaryLog::zigzag(e.micros - lastMicros));
+        lastMicros = e.micros;
+        *p++ = e.level;
+        if (e.isEvent) {
+            p = BinaryLog::putVarint(p, e.messageId);
+            *p++ = e.argc;
+            for (uint8_t i = 0; i < e.argc; ++i) {
+                *p++ = (uint8_t)e.args[i].type;
+                p = BinaryLog::putVarint(p, BinaryLog::zigzag(e.args[i].value));
+            }
+        } else {
+            p = BinaryLog::putVarint(p, e.textLength);
+            std::memcpy(p, e.text, e.textLength);
+            p += e.textLength;
+        }
+        return (size_t)(p - out);
+    }
+
+    /**
+     * @brief Скільки подій записано від старту (включно з уже витісненими).
+     */
+    uint64_t totalRecorded() const { return head.load(std::memory_order_relaxed); }
+};
@@ -0,0 +1,320 @@
+#pragma once
+#include <vector>
+#include <deque>
+#include <queue>
+#include <cstdlib>
+#include <climits>
+#include "Logger.h"
+#include "TileGrid.h"
+
+using namespace std;
+
+#ifndef UNTITLED23_FLOWFIELD_H
+#define UNTITLED23_FLOWFIELD_H
+#endif
+/**
+ * @brief Поле потоку (Dijkstra map) для руху ворогів до гравця.
+ * @details Поле будується один раз за хід ворогів пошуком у ширину від позиції гравця
+ * по всіх прохідних клітинках карти. Після цього кожен ворог знаходить свій наступний
+ * крок за O(1), просто спускаючись до сусідньої клітинки з меншою відстанню.
+ * На відміну від жадібного кроку по dx/dy, зомбі обходять стіни і не застрягають.
+ *
+ * Між ходами поле не перебудовується з нуля: якщо гравець зсунувся на одну клітинку,
+ * усі старі відстані збільшуються на 1 (через спільний зсув offset, за O(1)), а від нової
+ * цілі поширюється хвиля зменшення лише там, де шлях став коротшим. Оскільки
+ * d(v, нова) <= d(v, стара) + 1, результат точно збігається з повним перерахунком.
+ */
+class FlowField {
+public:
+    static constexpr int UNREACHABLE = INT_MAX; ///< Відстань до недосяжної клітинки
+
+private:
+    int width = 0, height = 0;
+    int targetX = -1, targetY = -1;
+    int offset = 0; ///< Спільний зсув: справжня відстань = dist[i] + offset
+    vector<int> dist; ///< Відстані до цілі (без зсуву), рядок за рядком
+    size_t lastUpdateCells = 0; ///< Скільки клітинок торкнулося останнє оновлення
+
+    static constexpr int DX[4] = {1, -1, 0, 0};
+    static constexpr int DY[4] = {0, 0, 1, -1};
+
+    int index(int x, int y) const { return y * width + x; }
+
+    /// Вороги ходять лише по підлозі: на зілля й патрони не стають (як і до поля потоку)
+    static bool isWalkable(uint8_t tile) { return tile == TILE_FLOOR; }
+
+    int trueDist(int cell) const {
+        return dist[cell] == UNREACHABLE ? UNREACHABLE : dist[cell] + offset;
+    }
+
+    void setTrueDist(int cell, int d) {
+        dist[cell] = (d == UNREACHABLE) ? UNREACHABLE : d - offset;
+    }
+
+    /**
+     * @brief Поширює зменшення відстаней від клітинок у черзі.
+     * @details Сусід оновлюється лише тоді, коли через поточну клітинку шлях коротший,
+     * тому хвиля зупиняється на межі області, де відстані не змінились.
+     */
+    void propagateDecrease(deque<int>& frontier, TileView grid) {
+        while (!frontier.empty()) {
+            int cell = frontier.front();
+            frontier.pop_front();
+            ++lastUpdateCells;
+            int cx = cell % width;
+            int cy = cell / width;
+            int next = trueDist(cell) + 1;
+
+            for (int i = 0; i < 4; ++i) {
+                int nx = cx + DX[i];
+                int ny = cy + DY[i];
+                if (!inBounds(nx, ny) || !isWalkable(grid.at(nx, ny))) continue;
+                int n = index(nx, ny);
+                if (trueDist(n) > next) {
+                    setTrueDist(n, next);
+                    frontier.push_back(n);
+                }
+            }
+        }
+    }
+
+    /**
+     * @brief Ремонт після того, як прохідна клітинка стала стіною.
+     * @details Спершу знаходимо клітинки, чий найкоротший шлях ішов лише через
+     * заблоковану (у них не лишилось сусіда з відстанню d-1 поза цією множиною),
+     * потім перераховуємо тільки їх від меж незачепленої області.
+     */
+    void repairIncrease(int blocked, TileView grid) {
+        int blockedDist = trueDist(blocked);
+        setTrueDist(blocked, UNREACHABLE);
+
+        vector<int> affected;
+        vector<char> isAffected(dist.size(), 0);
+        deque<int> pending;
+        int bx = blocked % width;
+        int by = blocked / width;
+        for (int i = 0; i < 4; ++i) {
+            int nx = bx + DX[i];
+            int ny = by + DY[i];
+            if (inBounds(nx, ny) && trueDist(index(nx, ny)) == blockedDist + 1) {
+                pending.push_back(index(nx, ny));
+            }
+        }
+
+        while (!pending.empty()) {
+            int cell = pending.front();
+            pending.pop_front();
+            if (isAffected[cell]) continue;
+            int d = trueDist(cell);
+            int cx = cell % width;
+            int cy = cell / width;
+
+            bool supported = false;
+            for (int i = 0; i < 4 && !supported; ++i) {
+                int nx = cx + DX[i];
+                int ny = cy + DY[i];
+                if (!inBounds(nx, ny)) continue;
+                int n = index(nx, ny);
+                supported = !isAffected[n] && n != blocked && trueDist(n) == d - 1;
+            }
+            if (supported) continue;
+
+            isAffected[cell] = 1;
+            affected.push_back(cell);
+            for (int i = 0; i < 4; ++i) {
+                int nx = cx + DX[i];
+                int ny = cy + DY[i];
+                if (inBounds(nx, ny) && trueDist(index(nx, ny)) == d + 1) {
+                    pending.push_back(index(nx, ny));
+                }
+            }
+        }
+
+        using Entry = pair<int, int>; // (відстань, клітинка)
+        priority_queue<Entry, vector<Entry>, greater<Entry>> open;
+        for (int cell : affected) {
+            int cx = cell % width;
+            int cy = cell / width;
+            int best = UNREACHABLE;
+            for (int i = 0; i < 4; ++i) {
+                int nx = cx + DX[i];
+                int ny = cy + DY[i];
+                if (!inBounds(nx, ny)) continue;
+                int n = index(nx, ny);
+                if (!isAffected[n] && trueDist(n) != UNREACHABLE && trueDist(n) + 1 < best) {
+                    best = trueDist(n) + 1;
+                }
+            }
+            setTrueDist(cell, best);
+            if (best != UNREACHABLE) open.push({best, cell});
+        }
+
+        while (!open.empty()) {
+            auto [d, cell] = open.top();
+            open.pop();
+            if (d != trueDist(cell)) continue;
+            ++lastUpdateCells;
+            int cx = cell % width;
+            int cy = cell / width;
+            for (int i = 0; i < 4; ++i) {
+                int nx = cx + DX[i];
+                int ny = cy + DY[i];
+                if (!inBounds(nx, ny) || !isWalkable(grid.at(nx, ny))) continue;
+                int n = index(nx, ny);
+                if (trueDist(n) > d + 1) {
+                    setTrueDist(n, d + 1);
+                    open.push({d + 1, n});
+                }
+            }
+        }
+    }
+
+public:
+    FlowField() = default;
+
+    /**
+     * @brief Повністю перераховує поле від нової цілі.
+     * @param tx Координата X цілі (гравця).
+     * @param ty Координата Y цілі (гравця).
+     * @param grid Карта.
+     */
+    void compute(int tx, int ty, TileView grid) {
+        height = grid.getHeight();
+        width = grid.getWidth();
+        targetX = tx;
+        targetY = ty;
+        offset = 0;
+        lastUpdateCells = 0;
+        dist.assign((size_t)width * height, UNREACHABLE);
+
+        if (!inBounds(tx, ty)) return;
+
+        deque<int> frontier;
+        dist[index(tx, ty)] = 0;
+        frontier.push_back(index(tx, ty));
+        propagateDecrease(frontier, grid);
+        LOG_DEBUG("Flow field rebuilt for target (" + to_string(tx) + "," + to_string(ty) + ")");
+    }
+
+    /**
+     * @brief Переносить ціль поля з інкрементальним ремонтом.
+     * @details Якщо ціль зсунулась рівно на одну клітинку, поле ремонтується лише
+     * там, де відстані зменшились. В інших випадках (перший хід, нова карта,
+     * стрибок цілі) виконується повний перерахунок.
+     * @param tx Нова координата X цілі.
+     * @param ty Нова координата Y цілі.
+     * @param grid Карта.
+     */
+    void retarget(int tx, int ty, TileView grid) {
+        if (grid.getWidth() != width || grid.getHeight() != height || !inBounds(targetX, targetY)) {
+            compute(tx, ty, grid);
+            return;
+        }
+        if (tx == targetX && ty == targetY) {
+            lastUpdateCells = 0;
+            return;
+        }
+        // Стара ціль на предметі не пропускала шляхів крізь себе — оцінка d + 1 тоді не діє
+        if (abs(tx - targetX) + abs(ty - targetY) != 1 || !inBounds(tx, ty) || !isWalkable(grid.at(tx, ty)) ||
+            !isWalkable(grid.at(targetX, targetY))) {
+            compute(tx, ty, grid);
+            return;
+        }
+
+        lastUpdateCells = 0;
+        targetX = tx;
+        targetY = ty;
+        ++offset; // кожна стара відстань стає верхньою межею d + 1
+
+        deque<int> frontier;
+        setTrueDist(index(tx, ty), 0);
+        frontier.push_back(index(tx, ty));
+        propagateDecrease(frontier, grid);
+    }
+
+    /**
+     * @brief Оновлює поле після зміни однієї клітинки карти (наприклад, Map::clearTile).
+     * @details Підбір предмета робить клітинку прохідною для ворогів.
+     * Якщо клітинка стала прохідною — поширюється зменшення, якщо стала стіною —
+     * перераховується лише область, що залежала від неї.
+     */
+    void updateTile(int x, int y, TileView grid) {
+        lastUpdateCells = 0;
+        if (!inBounds(x, y)) return;
+        int cell = index(x, y);
+        bool walkable = isWalkable(grid.at(x, y));
+
+        if (walkable && trueDist(cell) == UNREACHABLE) {
+            int best = UNREACHABLE;
+            for (int i = 0; i < 4; ++i) {
+                int nx = x + DX[i];
+                int ny = y + DY[i];
+                if (inBounds(nx, ny) && trueDist(index(nx, ny)) != UNREACHABLE) {
+                    best = min(best, trueDist(index(nx, ny)) + 1);
+                }
+            }
+            if (best == UNREACHABLE) return;
+            setTrueDist(cell, best);
+            deque<int> frontier{cell};
+            propagateDecrease(frontier, grid);
+        } else if (!walkable && trueDist(cell) != UNREACHABLE) {
+            if (x == targetX && y == targetY) {
+                compute(targetX, targetY, grid);
+                return;
+            }
+            repairIncrease(cell, grid);
+        }
+    }
+
+    /**
+     * @brief Кількість клітинок, оброблених останнім оновленням (для профілювання).
+     */
+    size_t getLastUpdateCells() const { return lastUpdateCells; }
+
+    bool inBounds(int x, int y) const { return x >= 0 && x < width && y >= 0 && y < height; }
+
+    /**
+     * @brief Повертає відстань від клітинки до цілі.
+     * @return Кількість кроків або UNREACHABLE.
+     */
+    int distanceAt(int x, int y) const {
+        return inBounds(x, y) ? trueDist(index(x, y)) : UNREACHABLE;
+    }
+
+    int getTargetX() const { return targetX; }
+    int getTargetY() const { return targetY; }
+
+    /**
+     * @brief Обирає наступний крок униз по полю.
+     * @details Перевіряє чотирьох сусідів і повертає того, що найближчий до цілі.
+     * Клітинки, для яких isBlocked повертає true (наприклад, зайняті іншим ворогом),
+     * пропускаються, тож ворог обходить перешкоду, якщо існує інший коротший шлях.
+     * @param x Поточна координата X.
+     * @param y Поточна координата Y.
+     * @param nextX Вихідна координата X наступного кроку.
+     * @param nextY Вихідна координата Y наступного кроку.
+     * @param isBlocked Предикат (x, y) -> bool для тимчасових перешкод.
+     * @return true, якщо знайдено крок, що наближає до цілі.
+     */
+    template<typename BlockedFn>
+    bool nextStep(int x, int y, int& nextX, int& nextY, BlockedFn isBlocked) const {
+        int best = distanceAt(x, y);
+        bool found = false;
+        for (int i = 0; i < 4; ++i) {
+            int nx = x + DX[i];
+            int ny = y + DY[i];
+            int d = distanceAt(nx, ny);
+            if (d < best && !isBlocked(nx, ny)) {
+                best = d;
+                nextX = nx;
+                nextY = ny;
+                found = true;
+            }
+        }
+        return found;
+    }
+
+    bool nextStep(int x, int y, int& nextX, int& nextY) const {
+        return nextStep(x, y, nextX, nextY, [](int, int) { return false; });
+    }
+};
@@ -5,8 +5,6 @@
  * та відображення (Render). Також відповідає за управління ресурсами (звуки, текстури).
  */
 #include "Game.h"
-#include "Zombie.h"
-#include "Boss.h"
 #include "Logger.h"
 #include <iostream>
 #include <string>
@@ -21,8 +19,7 @@
 Game::Game(sf::RenderWindow& win)
         : window(win),
           currentState(GameState::MainMenu),
-          player("Player", 100, 20, 1, 1),
-          map(15, 15, 20),
+          seedSource(std::random_device{}()),
           playerMaxHealth(100.0f),
           configMapWidth(15),
           configMapHeight(15),
@@ -32,6 +29,8 @@ Game::Game(sf::RenderWindow& win)
     gameView.setSize(800.f, 600.f);
     gameView.setCenter(window.getSize().x / 2.f, window.getSize().y / 2.f);
 
+    Logger::installCrashHandler();
+
     LOG_INFO("Game engine initialized. Window size: " +
              to_string(window.getSize().x) + "x" + to_string(window.getSize().y));
 
@@ -51,26 +50,16 @@ void Game::loadAssets() {
         LOG_ERR("CRITICAL: Could not load font '3Dumb.ttf'");
         errorOccurred = true;
     }
-    if (!playerTexture.loadFromFile("player.png") && !playerTexture.loadFromFile("assets/player.png")) {
-        LOG_ERR("Error loading player.png");
-        errorOccurred = true;
-    }
-    if (!zombieTexture.loadFromFile("zombie.png") && !zombieTexture.loadFromFile("assets/zombie.png")) {
-        LOG_ERR("Error loading zombie.png");
-        errorOccurred = true;
-    }
-    if (!bossTexture.loadFromFile("boss.png") && !bossTexture.loadFromFile("assets/boss.png"))   {
-        LOG_ERR("Error loading boss.png");
-        errorOccurred = true;
-    }
-    if (!wallTexture.loadFromFile("wall.png") && !wallTexture.loadFromFile("assets/wall.png"))     {
-        LOG_ERR("Error loading wall.png");
-        errorOccurred = true;
-    }
-    if (!floorTexture.loadFromFile("floor.png") && !floorTexture.loadFromFile("assets/floor.png"))   {
-        LOG_ERR("Error loading floor.png");
-        errorOccurred = true;
+    // Усі спрайти пакуються в один атлас, щоб карта й сутності малювалися однією текстурою
+    for (const char* sprite : {"player", "zombie", "boss", "wall", "floor"}) {
+        if (!atlas.loadImage(sprite, string(sprite) + ".png")) errorOccurred = true;
     }
+    if (!atlas.build()) errorOccurred = true;
+    playerRegion = atlas.get("player");
+    zombieRegion = atlas.get("zombie");
+    bossRegion = atlas.get("boss");
+    wallRegion = atlas.get("wall");
+    floorRegion = atlas.get("floor");
 
     if (!shootBuffer.loadFromFile("shoot.wav") && !shootBuffer.loadFromFile("assets/shoot.wav")) {
         LOG_ERR("Failed to load shoot.wav");
@@ -332,8 +321,9 @@ void Game::setupUI() {
             langUkrButton.getPosition().y + langBtnSize/2
     );
 
-    // Завантажуємо початкову мову (наприклад, EN)
+    // Завантажуємо початкову мову (наприклад, EN), решту — у фоні, щоб перемикання було миттєвим
     L10N.loadLanguage("en");
+    L10N.preloadLanguages({"ukr"});
     updateUITexts(); // Оновлюємо тексти відразу
 
 }
@@ -343,58 +333,15 @@ void Game::setupUI() {
 void Game::resetGame() {
     LOG_INFO("Resetting game state...");
 
+    SimConfig config;
+    config.mapWidth = configMapWidth;
+    config.mapHeight = configMapHeight;
+    config.enemyCount = configEnemyCount;
 
-    map = Map(configMapWidth, configMapHeight, 20);
-
-
-    player.reset(1, 1);
-    player.chooseWeapon(1);
-    enemies.clear();
-
-// Спавн Боса у дальньому куті
-    if (configEnemyCount > 0) {
-
-        int bossX = configMapWidth - 2;
-        int bossY = configMapHeight - 2;
-        if (map.getGrid()[bossY][bossX] == 1) { bossX--; }
-
-        enemies.add(make_unique<Boss>("BOSS", 120, 20, bossX, bossY, 7));
-        LOG_INFO("Boss spawned at (" + to_string(bossX) + "," + to_string(bossY) + ")");
-    }
-
-// Випадковий спавн зомбі на вільних клітинах
-    for (int i = 0; i < configEnemyCount - 1; ++i) {
-        int z_x, z_y;
-        bool validSpot = false;
-        int attempts = 0;
-
-        // Шукаємо вільне місце (до 50 спроб)
-        while (!validSpot && attempts < 50) {
-
-            z_x = 1 + rand() % (configMapWidth - 2);
-            z_y = 1 + rand() % (configMapHeight - 2);
-
-
-            int distToPlayer = abs(z_x - player.getX()) + abs(z_y - player.getY());
-            // Перевірка: не стіна і не занадто близько до гравця
-            if (map.getGrid()[z_y][z_x] != 1 && distToPlayer > 3) {
-                validSpot = true;
-            }
-            attempts++;
-        }
-
-        if (!validSpot) {
-            z_x = configMapWidth - 2;
-            z_y = configMapHeight - 2;
-        }
-
-        enemies.add(make_unique<Zombie>("Zombie " + std::to_string(i + 1), 50, 10, z_x, z_y));
-    }
-
+    sim.reset(config, requestedSeed ? *requestedSeed : seedSource());
+    requestedSeed.reset();
+    tileLayer.build(sim.getMap().getGrid(), atlas.getTexture(), floorRegion, wallRegion, atlas.get(TextureAtlas::WHITE));
 
-    LOG_INFO("Total enemies active: " + to_string(enemies.size()));
-
-    isPlayerTurn = true;
     logMessages.clear();
     addLogMessage("Game started! Press 'Q' to swap weapon.");
 }
@@ -403,32 +350,69 @@ void Game::runGameLoop() {
     while (window.isOpen()) {
         processEvents();
         update();
-        render();
+        // Стан змінюється лише від подій і мови, тож кадр малюється тільки після змін
+        if (dirty && window.isOpen()) {
+            render();
+            dirty = false;
+        }
     }
     LOG_INFO("Exiting main game loop.");
 }
 
+bool Game::isIdle() const {
+    // Фонове завантаження мови не будить вікно, тож поки воно триває, опитуємо події
+    return !dirty && L10N.getGeneration() == shownLanguageGeneration && !L10N.isLoading();
+}
+
 
 // --- ОБРОБКА ПОДІЙ ---
 void Game::processEvents() {
     sf::Event event;
+    // Нічого не змінилося — спимо до наступної події замість порожніх кадрів
+    if (isIdle()) {
+        if (window.waitEvent(event)) handleEvent(event);
+    } else if (!dirty) {
+        sf::sleep(sf::milliseconds(10)); // Чекаємо на фонову мову, не крутячись вхолосту
+    }
     while (window.pollEvent(event)) {
-        if (event.type == sf::Event::Closed) {
-            LOG_INFO("Window close event received.");
-            window.close();
-        }
+        handleEvent(event);
+    }
+}
+
+void Game::handleEvent(sf::Event& event) {
+    // Рух миші нічого не змінює на екрані (кнопки без підсвічування)
+    if (event.type != sf::Event::MouseMoved) {
+        dirty = true;
+    }
+
+    if (event.type == sf::Event::Closed) {
+        LOG_INFO("Window close event received.");
+        window.close();
+    }
 
-        switch (currentState) {
-            case GameState::MainMenu:       processMainMenuEvents(event); break;
-            case GameState::ConfigSelection: processConfigSelectionEvents(event); break;
-            case GameState::Playing:        processPlayingEvents(event);  break;
-            case GameState::Paused:         processPausedEvents(event);   break;
-            case GameState::GameOver:       processGameOverEvents(event); break;
+    // F12 у будь-якому стані: вивантажити останні події логу у файл
+    if (event.type == sf::Event::KeyPressed && event.key.code == sf::Keyboard::F12) {
+        if (Logger::getInstance().dumpFlightRecorder("flight_recorder.txt")) {
+            addLogMessage("Flight recorder saved to flight_recorder.txt");
         }
     }
+
+    switch (currentState) {
+        case GameState::MainMenu:       processMainMenuEvents(event); break;
+        case GameState::ConfigSelection: processConfigSelectionEvents(event); break;
+        case GameState::Playing:        processPlayingEvents(event);  break;
+        case GameState::Paused:         processPausedEvents(event);   break;
+        case GameState::GameOver:       processGameOverEvents(event); break;
+    }
 }
 
 void Game::update() {
+    // Нова мова опублікована (можливо, фоновим потоком) — оновлюємо тексти в цьому кадрі
+    if (L10N.getGeneration() != shownLanguageGeneration) {
+        updateUITexts();
+        dirty = true;
+    }
+    if (!dirty) return; // Хід, HUD і камера змінюються лише після подій
     if (currentState == GameState::Playing) {
         updatePlaying();
     }
@@ -464,18 +448,32 @@ void Game::processMainMenuEvents(sf::Event& event) {
         }
         if (langEnButton.getGlobalBounds().contains(mousePos)) {
             LOG_INFO("Language switched to English");
-            L10N.loadLanguage("en");
-            updateUITexts(); // Миттєве оновлення інтерфейсу
+            L10N.loadLanguageAsync("en"); // Тексти оновить update(), коли мову буде опубліковано
         }
 
         if (langUkrButton.getGlobalBounds().contains(mousePos)) {
             LOG_INFO("Language switched to Ukrainian");
-            L10N.loadLanguage("ukr");
-            updateUITexts(); // Миттєве оновлення інтерфейсу
+            L10N.loadLanguageAsync("ukr");
         }
     }
 }
 
+/**
+ * @brief Наступний розмір карти в меню: по одиниці до 30, далі вдвічі (велика карта генерується чанками).
+ */
+int Game::largerMapSize(int size) {
+    if (size < 30) return size + 1;
+    return std::min(size * 2, Map::MAX_SIZE);
+}
+
+/**
+ * @brief Попередній розмір карти в меню — обернено до largerMapSize.
+ */
+int Game::smallerMapSize(int size) {
+    if (size > 30) return std::max(size / 2, 30);
+    return std::max(size - 1, 15);
+}
+
 void Game::processConfigSelectionEvents(sf::Event& event) {
     if (event.type == sf::Event::MouseButtonPressed && event.mouseButton.button == sf::Mouse::Left) {
         sf::Vector2f mousePos = window.mapPixelToCoords(
@@ -484,16 +482,16 @@ void Game::processConfigSelectionEvents(sf::Event& event) {
         );
 
         if (mapWidthDecreaseButton.getGlobalBounds().contains(mousePos)) {
-            if (configMapWidth > 15) configMapWidth--;
+            configMapWidth = smallerMapSize(configMapWidth);
         }
         if (mapWidthIncreaseButton.getGlobalBounds().contains(mousePos)) {
-            if (configMapWidth < 30) configMapWidth++;
+            configMapWidth = largerMapSize(configMapWidth);
         }
         if (mapHeightDecreaseButton.getGlobalBounds().contains(mousePos)) {
-            if (configMapHeight > 15) configMapHeight--;
+            configMapHeight = smallerMapSize(configMapHeight);
         }
         if (mapHeightIncreaseButton.getGlobalBounds().contains(mousePos)) {
-            if (configMapHeight < 30) configMapHeight++;
+            configMapHeight = largerMapSize(configMapHeight);
         }
         if (enemyCountDecreaseButton.getGlobalBounds().contains(mousePos)) {
             if (configEnemyCount > 1) configEnemyCount--;
@@ -514,28 +512,23 @@ void Game::processConfigSelectionEvents(sf::Event& event) {
 }
 
 void Game::processPlayingEvents(sf::Event& event) {
-    if (isPlayerTurn && event.type == sf::Event::KeyPressed) {
-        bool actionTaken = false;
-        if (event.key.code == sf::Keyboard::W) { player.move(0, -1, map.getGrid()); actionTaken = true; }
-        if (event.key.code == sf::Keyboard::S) { player.move(0, 1, map.getGrid()); actionTaken = true; }
-        if (event.key.code == sf::Keyboard::A) { player.move(-1, 0, map.getGrid()); actionTaken = true; }
-        if (event.key.code == sf::Keyboard::D) { player.move(1, 0, map.getGrid()); actionTaken = true; }
-        if (event.key.code == sf::Keyboard::F) { handlePlayerAttack(); actionTaken = true; }
-
-
-        if (event.key.code == sf::Keyboard::Q) {
-            player.swapWeapon();
-            addLogMessage("Swapped to " + player.getWeaponName());
+    if (event.type == sf::Event::KeyPressed) {
+        std::optional<PlayerAction> action;
+        if (event.key.code == sf::Keyboard::W) action = PlayerAction::MoveUp;
+        if (event.key.code == sf::Keyboard::S) action = PlayerAction::MoveDown;
+        if (event.key.code == sf::Keyboard::A) action = PlayerAction::MoveLeft;
+        if (event.key.code == sf::Keyboard::D) action = PlayerAction::MoveRight;
+        if (event.key.code == sf::Keyboard::F) action = PlayerAction::Attack;
+        if (event.key.code == sf::Keyboard::Q) action = PlayerAction::SwapWeapon;
+
+        if (action && sim.act(*action)) {
+            presentEvents();
         }
 
         if (event.key.code == sf::Keyboard::Escape) {
             LOG_INFO("Game paused by user.");
             currentState = GameState::Paused;
         }
-
-        if (actionTaken && player.isAlive()) {
-            isPlayerTurn = false;
-        }
     }
 }
 
@@ -590,70 +583,7 @@ void Game::centerTextOrigin(sf::Text& text) {
 
 // --- ОНОВЛЕННЯ СТАНУ ГРИ ---
 void Game::updatePlaying() {
-
-    //Перевірка умови перемоги
-    if (currentState == GameState::Playing && enemies.size() == 0) {
-        LOG_INFO("VICTORY! All enemies defeated.");
-        currentState = GameState::GameOver;
-        gameOverTitleText.setString("Victory!");
-        centerTextOrigin(gameOverTitleText);
-        addLogMessage("All enemies defeated!");
-        return;
-    }
-
-    //ПІДБІР ПРЕДМЕТІВ
-    int tileType = map.getGrid()[player.getY()][player.getX()];
-
-    if (tileType == 2) { //Зілля
-        LOG_INFO("Picked up Health Potion");
-        player.heal(25);
-        map.clearTile(player.getX(), player.getY());
-        addLogMessage("Health Potion (+25 HP)");
-        pickupSound.play();
-    }
-    else if (tileType == 3) { // Патрони
-        LOG_INFO("Picked up Ammo Pack");
-        player.addAmmo(5);
-        map.clearTile(player.getX(), player.getY());
-        addLogMessage("Ammo Pack (+5 Ammo)");
-        pickupSound.play();
-    }
-
-
-    //Логіка ходу ворогів
-    if (!isPlayerTurn && player.isAlive()) {
-        const auto& allEnemiesRaw = enemies.getAllRaw();
-
-        for (auto* e : allEnemiesRaw) {
-            if (auto* z = dynamic_cast<Zombie*>(e)) {
-                int dx = abs(z->getX() - player.getX());
-                int dy = abs(z->getY() - player.getY());
-
-
-                if (dx + dy == 1) {
-                    int damage = dynamic_cast<Boss*>(z) ? 20 : 10;
-                    z->attack(player);
-                    hitSound.setPitch(0.8);
-                    hitSound.play();
-                    addLogMessage(z->getName() + " hits player for " + std::to_string(damage) + "!");
-
-                    if (!player.isAlive()) {
-                        LOG_INFO("DEFEAT. Player killed by " + z->getName());
-                        addLogMessage("Player has fallen!");
-                        currentState = GameState::GameOver;
-                        gameOverTitleText.setString("Defeat...");
-                        centerTextOrigin(gameOverTitleText);
-                        break;
-                    }
-                }
-                else {
-                    z->moveTowards(player.getX(), player.getY(), map.getGrid(), allEnemiesRaw);
-                }
-            }
-            if (currentState == GameState::GameOver) break;
-        }
-        isPlayerTurn = true;
-    }
+    const Player& player = sim.getPlayer();
 
     // 4. Оновлення HUD
     healthText.setString("Health: " + std::to_string(player.getHealth()));
@@ -694,15 +624,15 @@ void Game::renderConfigSelection() {
 
     window.draw(configTitleText);
 
-    mapWidthText.setString(L10N.getFormattedString("config_map_width", configMapWidth));
+    mapWidthText.setString(L10N.getFormattedString(l10nKey("config_map_width"), configMapWidth));
     centerTextOrigin(mapWidthText);
     window.draw(mapWidthText);
 
-    mapHeightText.setString(L10N.getFormattedString("config_map_height", configMapHeight));
+    mapHeightText.setString(L10N.getFormattedString(l10nKey("config_map_height"), configMapHeight));
     centerTextOrigin(mapHeightText);
     window.draw(mapHeightText);
 
-    enemyCountText.setString(L10N.getFormattedString("config_enemies", configEnemyCount));
+    enemyCountText.setString(L10N.getFormattedString(l10nKey("config_enemies"), configEnemyCount));
     centerTextOrigin(enemyCountText);
     window.draw(enemyCountText);
 
@@ -726,71 +656,32 @@ void Game::renderConfigSelection() {
 
 void Game::renderPlaying() {
     const int TILE_SIZE = 32;
+    const Player& player = sim.getPlayer();
+    const Map& map = sim.getMap();
+    const EnemyStore& enemies = sim.getEnemies();
 
     window.setView(gameView);
 
-    //Малюємо карту
-    for (int y = 0; y < configMapHeight; ++y) {
-        for (int x = 0; x < configMapWidth; ++x) {
-            int tileType = map.getGrid()[y][x];
-
-            sf::Sprite tileSprite;
-            tileSprite.setTexture((tileType == 1) ? wallTexture : floorTexture);
-
-            sf::FloatRect bounds = tileSprite.getLocalBounds();
-            tileSprite.setScale(
-                static_cast<float>(TILE_SIZE) / bounds.width,
-                static_cast<float>(TILE_SIZE) / bounds.height
-            );
-
-            tileSprite.setPosition(static_cast<float>(x * TILE_SIZE), static_cast<float>(y * TILE_SIZE));
-            window.draw(tileSprite);
-
-            // Зілля (2)
-            if (tileType == 2) {
-                sf::CircleShape potion(10.f);
-                potion.setFillColor(sf::Color::Green);
-                potion.setPosition(static_cast<float>(x * TILE_SIZE) + 6.f, static_cast<float>(y * TILE_SIZE) + 6.f);
-                window.draw(potion);
-            }
-            // Патрони (3)
-            else if (tileType == 3) {
-                sf::RectangleShape ammoBox({14.f, 14.f});
-                ammoBox.setFillColor(sf::Color::Yellow);
-                ammoBox.setOutlineColor(sf::Color::Black);
-                ammoBox.setOutlineThickness(1.f);
-                ammoBox.setPosition(static_cast<float>(x * TILE_SIZE) + 9.f, static_cast<float>(y * TILE_SIZE) + 9.f);
-                window.draw(ammoBox);
-            }
+    // Малюємо лише те, що видно: вартість кадру залежить від екрана, а не від розміру карти
+    sf::IntRect visible = TileLayer::visibleTiles(gameView, map.getGrid().getWidth(), map.getGrid().getHeight());
+    tileLayer.drawVisible(window, visible);
+
+    // Вороги й гравець — один масив вершин з атласа, один виклик draw.
+    // Ворогів шукаємо через шар зайнятості лише у видимих клітинках, а не перебором усіх
+    const sf::Vector2f tileSize(TILE_SIZE, TILE_SIZE);
+    entityBatch.begin(atlas.getTexture());
+    for (int y = visible.top; y < visible.top + visible.height; ++y) {
+        for (int x = visible.left; x < visible.left + visible.width; ++x) {
+            int32_t slot = sim.getOccupancy().occupantAt(x, y);
+            if (slot == OccupancyGrid::EMPTY) continue;
+            size_t i = enemies.findBySlot((uint32_t)slot);
+            if (i == EnemyStore::npos) continue;
+            const sf::IntRect& region = (enemies.getType(i) == EnemyType::Boss) ? bossRegion : zombieRegion;
+            entityBatch.add(region, {static_cast<float>(x * TILE_SIZE), static_cast<float>(y * TILE_SIZE)}, tileSize);
         }
     }
-
-    for (auto* e : enemies.getAllRaw()) {
-        if (auto* z = dynamic_cast<Zombie*>(e)) {
-            sf::Sprite enemySprite;
-            enemySprite.setTexture(dynamic_cast<Boss*>(z) ? bossTexture : zombieTexture);
-
-            sf::FloatRect bounds = enemySprite.getLocalBounds();
-            enemySprite.setScale(
-                static_cast<float>(TILE_SIZE) / bounds.width,
-                static_cast<float>(TILE_SIZE) / bounds.height
-            );
-
-            enemySprite.setPosition(static_cast<float>(z->getX() * TILE_SIZE), static_cast<float>(z->getY() * TILE_SIZE));
-            window.draw(enemySprite);
-        }
-    }
-
-    sf::Sprite playerSprite(playerTexture);
-
-    sf::FloatRect pBounds = playerSprite.getLocalBounds();
-    playerSprite.setScale(
-        static_cast<float>(TILE_SIZE) / pBounds.width,
-        static_cast<float>(TILE_SIZE) / pBounds.height
-    );
-
-    playerSprite.setPosition(static_cast<float>(player.getX() * TILE_SIZE), static_cast<float>(player.getY() * TILE_SIZE));
-    window.draw(playerSprite);
+    entityBatch.add(playerRegion, {static_cast<float>(player.getX() * TILE_SIZE), static_cast<float>(player.getY() * TILE_SIZE)}, tileSize);
+    window.draw(entityBatch);
 
     //Рендер HUD
     window.setView(window.getDefaultView());
@@ -831,7 +722,7 @@ void Game::renderPaused() {
 void Game::renderGameOver() {
     window.setView(window.getDefaultView());
 
-    finalScoreText.setString("Final Score: " + std::to_string(player.getScore()));
+    finalScoreText.setString("Final Score: " + std::to_string(sim.getPlayer().getScore()));
     centerTextOrigin(finalScoreText);
     finalScoreText.setPosition(window.getSize().x / 2.0f, gameOverTitleText.getPosition().y + 70.f);
 
@@ -843,62 +734,65 @@ void Game::renderGameOver() {
     window.draw(gameOverExitButtonText);
 }
 
-void Game::handlePlayerAttack() {
-    bool attacked = false;
-    int weaponRange = player.getWeaponRange();
-
-    for (size_t i = 0; i < enemies.size(); ++i) {
-        if (auto* z = dynamic_cast<Zombie*>(enemies.get(i))) {
-
-            int dx = abs(z->getX() - player.getX());
-            int dy = abs(z->getY() - player.getY());
-            int dist = dx + dy;
-
-            if (dist <= weaponRange) {
-
-                if (!player.canAttack()) {
-                    addLogMessage("Click! No Ammo!");
-                    continue;
-                }
-                if (player.getWeaponName() == "Gun") {
+/**
+ * @brief Показує наслідки останнього ходу симуляції: звуки, журнал, карта, кінець гри.
+ */
+void Game::presentEvents() {
+    for (const SimEvent& e : sim.getEvents()) {
+        switch (e.type) {
+            case SimEvent::Type::WeaponSwapped:
+                addLogMessage("Swapped to " + e.name);
+                break;
+            case SimEvent::Type::PickedPotion:
+                tileLayer.updateTile(e.x, e.y, sim.getMap().getGrid());
+                addLogMessage("Health Potion (+25 HP)");
+                pickupSound.play();
+                break;
+            case SimEvent::Type::PickedAmmo:
+                tileLayer.updateTile(e.x, e.y, sim.getMap().getGrid());
+                addLogMessage("Ammo Pack (+5 Ammo)");
+                pickupSound.play();
+                break;
+            case SimEvent::Type::NoTarget:
+                addLogMessage("No enemy in range!");
+                break;
+            case SimEvent::Type::NoAmmo:
+                addLogMessage("Click! No Ammo!");
+                break;
+            case SimEvent::Type::PlayerStrikes:
+                if (sim.getPlayer().getWeaponName() == "Gun") {
                     shootSound.play();
                 } else {
                     hitSound.setPitch(1.5);
                     hitSound.play();
                 }
-
-                LOG_DEBUG("Player engaged enemy: " + z->getName());
-
-                int damage = 20;
-                player.attack(*z);
-                addLogMessage("Player hits " + z->getName() + "!");
-
-                if (!player.isAlive()) {
-                    LOG_INFO("Player died during attack phase.");
-                    addLogMessage("Player has fallen!");
-                    currentState = GameState::GameOver;
-                    gameOverTitleText.setString("Defeat...");
-                    centerTextOrigin(gameOverTitleText);
-                    break;
-                }
-
-                attacked = true;
-                if (!z->isAlive()) {
-                    LOG_INFO("Enemy neutralized: " + z->getName());
-                    addLogMessage(z->getName() + " defeated!");
-                    player.addScore(50);
-                    enemies.remove(i);
-                    zombieSound.play();
-                }
+                addLogMessage("Player hits " + e.name + "!");
+                break;
+            case SimEvent::Type::EnemyKilled:
+                addLogMessage(e.name + " defeated!");
+                zombieSound.play();
+                break;
+            case SimEvent::Type::EnemyHitsPlayer:
+                hitSound.setPitch(0.8);
+                hitSound.play();
+                addLogMessage(e.name + " hits player for " + std::to_string(e.value) + "!");
+                break;
+            case SimEvent::Type::WindowMoved:
+                // Вікно великої карти зсунулося — шар перезапікається з нових тайлів
+                tileLayer.build(sim.getMap().getGrid(), atlas.getTexture(), floorRegion, wallRegion, atlas.get(TextureAtlas::WHITE));
+                break;
+            case SimEvent::Type::PlayerDied:
+                addLogMessage("Player has fallen!");
+                currentState = GameState::GameOver;
+                gameOverTitleText.setString("Defeat...");
+                centerTextOrigin(gameOverTitleText);
+                break;
+            case SimEvent::Type::Victory:
+                addLogMessage("All enemies defeated!");
+                currentState = GameState::GameOver;
+                gameOverTitleText.setString("Victory!");
+                centerTextOrigin(gameOverTitleText);
                 break;
-            }
-        }
-    }
-
-    if (!attacked) {
-        if (player.getAmmo() <= 0 && player.getWeaponRange() > 1) {
-        } else {
-             addLogMessage("No enemy in range!");
         }
     }
 }
@@ -916,41 +810,43 @@ void Game::addLogMessage(const std::string& message) {
 }
 
 void Game::updateUITexts() {
+    shownLanguageGeneration = L10N.getGeneration();
+
     // Головне меню
-    menuTitleText.setString(L10N.getString("game_title"));
+    menuTitleText.setString(L10N.getString(l10nKey("game_title")));
     centerTextOrigin(menuTitleText);
 
-    playButtonText.setString(L10N.getString("menu_new_game"));
+    playButtonText.setString(L10N.getString(l10nKey("menu_new_game")));
     centerTextOrigin(playButtonText);
 
-    exitButtonText.setString(L10N.getString("menu_exit"));
+    exitButtonText.setString(L10N.getString(l10nKey("menu_exit")));
     centerTextOrigin(exitButtonText);
 
     // Конфігурація
-    configTitleText.setString(L10N.getString("config_title"));
+    configTitleText.setString(L10N.getString(l10nKey("config_title")));
     centerTextOrigin(configTitleText);
-    configStartButtonText.setString(L10N.getString("config_start"));
+    configStartButtonText.setString(L10N.getString(l10nKey("config_start")));
     centerTextOrigin(configStartButtonText);
-    configBackButtonText.setString(L10N.getString("config_back"));
+    configBackButtonText.setString(L10N.getString(l10nKey("config_back")));
     centerTextOrigin(configBackButtonText);
 
     // Пауза
-    pauseTitleText.setString(L10N.getString("paused"));
+    pauseTitleText.setString(L10N.getString(l10nKey("paused")));
     centerTextOrigin(pauseTitleText);
-    resumeButtonText.setString(L10N.getString("resume"));
+    resumeButtonText.setString(L10N.getString(l10nKey("resume")));
     centerTextOrigin(resumeButtonText);
-    pauseRestartButtonText.setString(L10N.getString("restart"));
+    pauseRestartButtonText.setString(L10N.getString(l10nKey("restart")));
     centerTextOrigin(pauseRestartButtonText);
-    pauseToMenuButtonText.setString(L10N.getString("to_menu"));
+    pauseToMenuButtonText.setString(L10N.getString(l10nKey("to_menu")));
     centerTextOrigin(pauseToMenuButtonText);
-    pauseExitDesktopButtonText.setString(L10N.getString("to_desktop"));
+    pauseExitDesktopButtonText.setString(L10N.getString(l10nKey("to_desktop")));
     centerTextOrigin(pauseExitDesktopButtonText);
 
     // Game Over
     if (currentState == GameState::GameOver) {
-        restartButtonText.setString(L10N.getString("restart"));
+        restartButtonText.setString(L10N.getString(l10nKey("restart")));
         centerTextOrigin(restartButtonText);
-        gameOverExitButtonText.setString(L10N.getString("to_menu"));
+        gameOverExitButtonText.setString(L10N.getString(l10nKey("to_menu")));
         centerTextOrigin(gameOverExitButtonText);
     }
 }
@@ -2,9 +2,12 @@
 #include <SFML/Graphics.hpp>
 #include <SFML/Audio.hpp>
 #include <deque>
-#include "Player.h"
-#include "Map.h"
-#include "Container.h"
+#include <random>
+#include <optional>
+#include "Simulation.h"
+#include "TileLayer.h"
+#include "TextureAtlas.h"
+#include "SpriteBatch.h"
 #include "LocalizationManager.h"
 
 class Command;
@@ -30,11 +33,15 @@ private:
     void centerTextOrigin(sf::Text& text);
 
     // --- Ігрові об'єкти ---
-    Player player;
-    Container<Entity> enemies;
-    Map map;
+    Simulation sim; ///< Уся ігрова логіка: карта, гравець, вороги, ходи
+    uint64_t shownLanguageGeneration = 0; ///< Публікація мови, з якої зібрано тексти інтерфейсу
+    TileLayer tileLayer; ///< Карта, запечена у вершини; малюється кількома викликами draw
     sf::View gameView;
 
+    // --- Випадковість ---
+    std::mt19937_64 seedSource; ///< Джерело зерен для нових сесій
+    std::optional<uint64_t> requestedSeed; ///< Зерно, задане ззовні для наступної гри
+
     // --- Змінні конфігурації гри ---
     int configMapWidth;
     int configMapHeight;
@@ -43,11 +50,13 @@ private:
 
     // --- Графічні ресурси ---
     sf::Font font;
-    sf::Texture floorTexture;
-    sf::Texture wallTexture;
-    sf::Texture playerTexture;
-    sf::Texture zombieTexture;
-    sf::Texture bossTexture;
+    TextureAtlas atlas; ///< Усі спрайти в одній текстурі
+    sf::IntRect floorRegion;
+    sf::IntRect wallRegion;
+    sf::IntRect playerRegion;
+    sf::IntRect zombieRegion;
+    sf::IntRect bossRegion;
+    SpriteBatch entityBatch; ///< Вороги й гравець, один виклик draw на кадр
 
     // --- Елементи інтерфейсу (UI) ---
 
@@ -108,7 +117,7 @@ private:
     std::deque<sf::Text> logMessages;
     const size_t MAX_LOG_MESSAGES = 4;
 
-    bool isPlayerTurn = true;
+    bool dirty = true; ///< Стан змінився після останнього кадру — треба оновити й перемалювати
 
 
     // Звуки
@@ -135,6 +144,8 @@ private:
     void loadAssets();
     void setupUI();
     void processEvents();
+    void handleEvent(sf::Event& event);
+    bool isIdle() const;
     void update();
     void render();
     void processMainMenuEvents(sf::Event& event);
@@ -148,10 +159,12 @@ private:
     void renderPlaying();
     void renderPaused();
     void renderGameOver();
-    void handlePlayerAttack();
+    void presentEvents();
     void addLogMessage(const std::string& message);
     void resetGame();
     void updateUITexts();
+    static int largerMapSize(int size);
+    static int smallerMapSize(int size);
 
 public:
     Game(sf::RenderWindow& win);
@@ -159,7 +172,14 @@ public:
 
     void runGameLoop();
 
-    Player& getPlayer() { return player; }
-    Map& getMap() { return map; }
-    Container<Entity>& getEnemies() { return enemies; }
+    Player& getPlayer() { return sim.getPlayer(); }
+    Map& getMap() { return sim.getMap(); }
+    EnemyStore& getEnemies() { return sim.getEnemies(); }
+    const Simulation& getSimulation() const { return sim; }
+
+    /**
+     * @brief Задає зерно для наступної гри (для відтворення сесії).
+     */
+    void setWorldSeed(uint64_t seed) { requestedSeed = seed; }
+    uint64_t getWorldSeed() const { return sim.getSeed(); }
 };
\ No newline at end of file
@@ -2,7 +2,6 @@
 #include "Weapon.h"
 #include <iostream>
 #include <vector>
-#include "LocalizationManager.h"
 #include "Logger.h"
 
 using namespace std;
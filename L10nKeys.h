@@ -0,0 +1,81 @@
+#pragma once
+#include <cstdint>
+#include <cstddef>
+#include <string_view>
+
+#ifndef UNTITLED23_L10NKEYS_H
+#define UNTITLED23_L10NKEYS_H
+#endif
+/**
+ * @brief Перелік усіх ключів локалізації, які використовує код.
+ * @details Номер ключа у цьому списку — його стабільний id та індекс у плоскій таблиці
+ * LanguageTable::byId. Виклик l10nKey("...") обчислюється під час компіляції, тож
+ * у рантаймі лишається лише звернення до масиву, а помилка в ключі — це помилка компіляції.
+ * Під час збірки cmake/CheckL10nKeys.cmake перевіряє, що кожен ключ є в en.json і ukr.json.
+ * Новий ключ: додати сюди, в assets/en.json і в assets/ukr.json.
+ */
+namespace L10nKeys {
+    inline constexpr std::string_view names[] = {
+            "game_title",
+            "menu_new_game",
+            "menu_exit",
+            "menu_config",
+            "config_title",
+            "config_start",
+            "config_back",
+            "game_over",
+            "victory",
+            "restart",
+            "paused",
+            "resume",
+            "to_menu",
+            "to_desktop",
+            "choose_weapon",
+            "weapon_already_chosen",
+            "player_equipped",
+            "entity_takes_damage",
+            "target_hp_remaining",
+            "player_attack_header",
+            "zombie_attack_header",
+            "boss_attack_header",
+            "player_attacks_target",
+            "zombie_bites_target",
+            "boss_attacks_target",
+            "player_deals_damage",
+            "player_no_weapon",
+            "cant_move_wall",
+            "invalid_weapon_choice",
+            "no_enemy_in_range",
+            "config_map_width",
+            "config_map_height",
+            "config_enemies",
+    };
+
+    inline constexpr size_t COUNT = sizeof(names) / sizeof(names[0]);
+
+    consteval bool unique() {
+        for (size_t i = 0; i < COUNT; ++i)
+            for (size_t j = i + 1; j < COUNT; ++j)
+                if (names[i] == names[j]) return false;
+        return true;
+    }
+    static_assert(unique(), "Duplicate localization key in L10nKeys::names");
+}
+
+/**
+ * @brief Id ключа локалізації (індекс у L10nKeys::names).
+ */
+struct L10nId {
+    uint16_t index;
+};
+
+/**
+ * @brief Перетворює ключ на id під час компіляції.
+ * @details Невідомий ключ не дає програмі скомпілюватися.
+ */
+consteval L10nId l10nKey(std::string_view key) {
+    for (size_t i = 0; i < L10nKeys::COUNT; ++i) {
+        if (L10nKeys::names[i] == key) return L10nId{(uint16_t)i};
+    }
+    throw "Unknown localization key: add it to L10nKeys.h, en.json and ukr.json";
+}
@@ -0,0 +1,365 @@
+#pragma once
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <string_view>
+#include <vector>
+#include <charconv>
+#include <system_error>
+
+#if defined(_WIN32) || defined(_WIN64)
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#ifndef UNTITLED23_LANGUAGEBUNDLE_H
+#define UNTITLED23_LANGUAGEBUNDLE_H
+#endif
+/**
+ * @brief Бінарний мовний пакет (*.l10n) — спільний для LocalizationManager і l10nbundle.
+ * @details Файл будується з JSON під час збирання і читається як є, без розбору:
+ *  - Header (32 байти): "ZL10", версія, кількості записів і сегментів, розміри пулів;
+ *  - Entry[entryCount]: записи, відсортовані за ключем (пошук — двійковий);
+ *  - Segment[segmentCount]: попередньо розібрані шматки шаблонів (літерал або слот {N});
+ *  - uint32_t[u32Size]: усі тексти, уже декодовані в UTF-32;
+ *  - char[poolSize]: ті самі тексти в UTF-8 (для логера та діагностики);
+ *  - char[keyPoolSize]: ключі.
+ * Усі числа — uint32_t у порядку байтів машини (пакет збирається тим самим тулчейном, що й гра).
+ * Масиви до UTF-8 пулу мають розміри, кратні 4, тож при відображенні (mmap) все вирівняно.
+ */
+namespace LanguageBundle {
+    constexpr char MAGIC[4] = {'Z', 'L', '1', '0'};
+    constexpr uint32_t VERSION = 1;
+
+    using U32String = std::basic_string<uint32_t>; ///< Той самий тип, що й у sf::String
+
+    struct Header {
+        char magic[4];
+        uint32_t version;
+        uint32_t entryCount;
+        uint32_t segmentCount;
+        uint32_t u32Size;     ///< Символів у UTF-32 пулі
+        uint32_t poolSize;    ///< Байтів в UTF-8 пулі
+        uint32_t keyPoolSize; ///< Байтів у пулі ключів
+        uint32_t reserved;
+    };
+
+    /**
+     * @brief Шматок шаблону: літерал або слот аргументу.
+     * @details Для слота offset/length вказують на сам текст "{N}" — він виводиться,
+     * якщо аргументу з таким номером не передали.
+     */
+    struct Segment {
+        uint32_t offset;    ///< Початок в UTF-8 пулі
+        uint32_t length;    ///< Довжина в байтах
+        int32_t arg;        ///< Номер аргументу або -1 для літерала
+        uint32_t u32Offset; ///< Початок в UTF-32 пулі
+        uint32_t u32Length; ///< Довжина в символах UTF-32
+    };
+
+    /**
+     * @brief Запис: ключ, увесь текст і діапазон його сегментів.
+     */
+    struct Entry {
+        uint32_t keyOffset;
+        uint32_t keyLength;
+        uint32_t offset;
+        uint32_t length;
+        uint32_t firstSegment;
+        uint32_t segmentCount;
+        uint32_t u32Offset;
+        uint32_t u32Length;
+    };
+
+    static_assert(sizeof(Header) == 32 && sizeof(Entry) == 32 && sizeof(Segment) == 20,
+                  "Bundle records must have no padding");
+
+    /**
+     * @brief Декодує UTF-8 і дописує символи в UTF-32 (некоректні байти стають '?').
+     */
+    inline void appendUtf32(U32String& out, std::string_view utf8) {
+        for (size_t i = 0; i < utf8.size();) {
+            unsigned char c = (unsigned char)utf8[i];
+            uint32_t cp;
+            size_t extra;
+            if (c < 0x80) { cp = c; extra = 0; }
+            else if ((c & 0xE0) == 0xC0) { cp = c & 0x1F; extra = 1; }
+            else if ((c & 0xF0) == 0xE0) { cp = c & 0x0F; extra = 2; }
+            else if ((c & 0xF8) == 0xF0) { cp = c & 0x07; extra = 3; }
+            else { out += '?'; ++i; continue; }
+
+            if (i + extra >= utf8.size()) { // Обірваний символ у кінці
+                out += '?';
+                break;
+            }
+            bool valid = true;
+            for (size_t k = 1; k <= extra; ++k) {
+                unsigned char cc = (unsigned char)utf8[i + k];
+                if ((cc & 0xC0) != 0x80) { valid = false; break; }
+                cp = (cp << 6) | (cc & 0x3F);
+            }
+            if (!valid) { out += '?'; ++i; continue; }
+            out += cp;
+            i += extra + 1;
+        }
+    }
+
+    /**
+     * @brief Збирає пакет з пар ключ-шаблон.
+     */
+    class Builder {
+        std::vector<std::pair<std::string, std::string>> items;
+
+        template<typename T>
+        static void put(std::string& out, const std::vector<T>& records) {
+            out.append((const char*)records.data(), records.size() * sizeof(T));
+        }
+
+    public:
+        void add(std::string key, std::string value) {
+            items.emplace_back(std::move(key), std::move(value));
+        }
+
+        /**
+         * @brief Розбирає плейсхолдери {N}, декодує тексти й повертає вміст файлу.
+         */
+        std::string build() const {
+            std::vector<std::pair<std::string, std::string>> sorted = items;
+            std::stable_sort(sorted.begin(), sorted.end(),
+                             [](const auto& a, const auto& b) { return a.first < b.first; });
+            // Для однакових ключів лишаємо останній, як при повторному присвоєнні
+            std::vector<std::pair<std::string, std::string>> unique;
+            for (auto& item : sorted) {
+                if (!unique.empty() && unique.back().first == item.first) unique.back() = std::move(item);
+                else unique.push_back(std::move(item));
+            }
+
+            std::vector<Entry> entries;
+            std::vector<Segment> segments;
+            U32String u32pool;
+            std::string pool;
+            std::string keys;
+
+            for (const auto& [key, value] : unique) {
+                Entry e;
+                e.keyOffset = (uint32_t)keys.size();
+                e.keyLength = (uint32_t)key.size();
+                keys += key;
+                e.offset = (uint32_t)pool.size();
+                e.length = (uint32_t)value.size();
+                e.firstSegment = (uint32_t)segments.size();
+                e.u32Offset = (uint32_t)u32pool.size();
+                pool += value;
+
+                size_t literalStart = 0;
+                for (size_t i = 0; i < value.size(); ++i) {
+                    if (value[i] != '{') continue;
+                    size_t close = i + 1;
+                    while (close < value.size() && value[close] >= '0' && value[close] <= '9') ++close;
+                    if (close == i + 1 || close >= value.size() || value[close] != '}') continue;
+                    // Номер, що не влазить в int32_t, лишається текстом, як у BinaryLog::fillTemplate
+                    int32_t arg = 0;
+                    if (std::from_chars(value.data() + i + 1, value.data() + close, arg).ec != std::errc()) continue;
+
+                    if (i > literalStart) {
+                        segments.push_back({e.offset + (uint32_t)literalStart, (uint32_t)(i - literalStart), -1, 0, 0});
+                    }
+                    segments.push_back({e.offset + (uint32_t)i, (uint32_t)(close + 1 - i), arg, 0, 0});
+                    literalStart = close + 1;
+                    i = close;
+                }
+                if (literalStart < value.size()) {
+                    segments.push_back({e.offset + (uint32_t)literalStart, (uint32_t)(value.size() - literalStart), -1, 0, 0});
+                }
+                e.segmentCount = (uint32_t)segments.size() - e.firstSegment;
+
+                // Сегменти йдуть підряд, тож декодований запис — це їх декодовані шматки поспіль
+                for (uint32_t s = e.firstSegment; s < e.firstSegment + e.segmentCount; ++s) {
+                    segments[s].u32Offset = (uint32_t)u32pool.size();
+                    appendUtf32(u32pool, std::string_view(pool).substr(segments[s].offset, segments[s].length));
+                    segments[s].u32Length = (uint32_t)u32pool.size() - segments[s].u32Offset;
+                }
+                e.u32Length = (uint32_t)u32pool.size() - e.u32Offset;
+                entries.push_back(e);
+            }
+
+            Header header{};
+            std::memcpy(header.magic, MAGIC, sizeof(MAGIC));
+            header.version = VERSION;
+            header.entryCount = (uint32_t)entries.size();
+            header.segmentCount = (uint32_t)segments.size();
+            header.u32Size = (uint32_t)u32pool.size();
+            header.poolSize = (uint32_t)pool.size();
+            header.keyPoolSize = (uint32_t)keys.size();
+
+            std::string out;
+            out.reserve(sizeof(Header) + entries.size() * sizeof(Entry) + segments.size() * sizeof(Segment) +
+                        u32pool.size() * sizeof(uint32_t) + pool.size() + keys.size());
+            out.append((const char*)&header, sizeof(header));
+            put(out, entries);
+            put(out, segments);
+            out.append((const char*)u32pool.data(), u32pool.size() * sizeof(uint32_t));
+            out += pool;
+            out += keys;
+            return out;
+        }
+    };
+
+    /**
+     * @brief Перегляд готового пакета в пам'яті (відображеного файлу або буфера).
+     * @details Нічого не копіює; пам'ять має жити, доки живе View.
+     */
+    class View {
+        const Header* header = nullptr;
+        const Entry* entries = nullptr;
+        const Segment* segments = nullptr;
+        const uint32_t* u32pool = nullptr;
+        const char* pool = nullptr;
+        const char* keys = nullptr;
+
+    public:
+        /**
+         * @brief Перевіряє заголовок і межі всіх записів.
+         * @return false, якщо дані обрізані, іншої версії чи пошкоджені.
+         */
+        bool open(const char* data, size_t size) {
+            header = nullptr;
+            if (size < sizeof(Header) || ((uintptr_t)data % alignof(uint32_t)) != 0) return false;
+            const Header* h = (const Header*)data;
+            if (std::memcmp(h->magic, MAGIC, sizeof(MAGIC)) != 0 || h->version != VERSION) return false;
+
+            uint64_t expected = sizeof(Header) + (uint64_t)h->entryCount * sizeof(Entry) +
+                                (uint64_t)h->segmentCount * sizeof(Segment) + (uint64_t)h->u32Size * sizeof(uint32_t) +
+                                h->poolSize + h->keyPoolSize;
+            if (expected != size) return false;
+
+            const char* p = data + sizeof(Header);
+            const Entry* e = (const Entry*)p;
+            p += (size_t)h->entryCount * sizeof(Entry);
+            const Segment* s = (const Segment*)p;
+            p += (size_t)h->segmentCount * sizeof(Segment);
+            const uint32_t* u = (const uint32_t*)p;
+            p += (size_t)h->u32Size * sizeof(uint32_t);
+
+            for (uint32_t i = 0; i < h->entryCount; ++i) {
+                if ((uint64_t)e[i].keyOffset + e[i].keyLength > h->keyPoolSize ||
+                    (uint64_t)e[i].offset + e[i].length > h->poolSize ||
+                    (uint64_t)e[i].u32Offset + e[i].u32Length > h->u32Size ||
+                    (uint64_t)e[i].firstSegment + e[i].segmentCount > h->segmentCount) return false;
+            }
+            for (uint32_t i = 0; i < h->segmentCount; ++i) {
+                if ((uint64_t)s[i].offset + s[i].length > h->poolSize ||
+                    (uint64_t)s[i].u32Offset + s[i].u32Length > h->u32Size) return false;
+            }
+
+            header = h;
+            entries = e;
+            segments = s;
+            u32pool = u;
+            pool = p;
+            keys = p + h->poolSize;
+            return true;
+        }
+
+        bool isOpen() const { return header != nullptr; }
+        size_t size() const { return header ? header->entryCount : 0; }
+
+        const Entry& entry(size_t i) const { return entries[i]; }
+        size_t indexOf(const Entry* e) const { return (size_t)(e - entries); }
+        const Segment& segment(size_t i) const { return segments[i]; }
+
+        std::string_view key(const Entry& e) const { return std::string_view(keys + e.keyOffset, e.keyLength); }
+        std::string_view text(const Entry& e) const { return std::string_view(pool + e.offset, e.length); }
+        const uint32_t* u32(uint32_t offset) const { return u32pool + offset; }
+
+        /**
+         * @brief Запис за ключем (двійковий пошук) або nullptr.
+         */
+        const Entry* find(std::string_view k) const {
+            const Entry* begin = entries;
+            const Entry* end = entries + size();
+            const Entry* it = std::lower_bound(begin, end, k,
+                                               [this](const Entry& e, std::string_view k) { return key(e) < k; });
+            return (it != end && key(*it) == k) ? it : nullptr;
+        }
+    };
+
+    /**
+     * @brief Файл, відображений у пам'ять лише для читання.
+     * @details Відображений файл не можна переписувати на місці (на POSIX обрізання дає
+     * SIGBUS, на Windows файл зайнятий) — новий пакет кладуть поруч і перейменовують
+     * поверх старого, як l10nbundle. На Windows для цього файл відкрито з FILE_SHARE_DELETE.
+     */
+    class MappedFile {
+        const char* data = nullptr;
+        size_t length = 0;
+#if defined(_WIN32) || defined(_WIN64)
+        HANDLE file = INVALID_HANDLE_VALUE;
+        HANDLE mapping = nullptr;
+#endif
+
+    public:
+        MappedFile() = default;
+        MappedFile(const MappedFile&) = delete;
+        MappedFile& operator=(const MappedFile&) = delete;
+        ~MappedFile() { close(); }
+
+        /**
+         * @return false, якщо файл не існує, порожній чи не відображається.
+         */
+        bool open(const std::string& path) {
+            close();
+#if defined(_WIN32) || defined(_WIN64)
+            file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_DELETE, nullptr, OPEN_EXISTING,
+                               FILE_ATTRIBUTE_NORMAL, nullptr);
+            if (file == INVALID_HANDLE_VALUE) return false;
+            LARGE_INTEGER fileSize;
+            if (!GetFileSizeEx(file, &fileSize) || fileSize.QuadPart == 0) { close(); return false; }
+            mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+            if (!mapping) { close(); return false; }
+            data = (const char*)MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+            if (!data) { close(); return false; }
+            length = (size_t)fileSize.QuadPart;
+#else
+            int fd = ::open(path.c_str(), O_RDONLY);
+            if (fd < 0) return false;
+            struct stat st;
+            if (fstat(fd, &st) != 0 || st.st_size == 0) { ::close(fd); return false; }
+            void* mapped = mmap(nullptr, (size_t)st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+            ::close(fd); // Відображення лишається дійсним і після закриття дескриптора
+            if (mapped == MAP_FAILED) return false;
+            data = (const char*)mapped;
+            length = (size_t)st.st_size;
+#endif
+            return true;
+        }
+
+        void close() {
+#if defined(_WIN32) || defined(_WIN64)
+            if (data) UnmapViewOfFile(data);
+            if (mapping) CloseHandle(mapping);
+            if (file != INVALID_HANDLE_VALUE) CloseHandle(file);
+            mapping = nullptr;
+            file = INVALID_HANDLE_VALUE;
+#else
+            if (data) munmap((void*)data, length);
+#endif
+            data = nullptr;
+            length = 0;
+        }
+
+        const char* bytes() const { return data; }
+        size_t size() const { return length; }
+    };
+}
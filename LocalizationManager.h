@@ -1,12 +1,26 @@
 #pragma once
 #include <iostream>
 #include <string>
+#include <string_view>
 #include <map>
+#include <unordered_map>
 #include <fstream>
 #include <vector>
 #include <sstream>
+#include <charconv>
+#include <type_traits>
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <condition_variable>
+#include <thread>
+#include <deque>
+#include <filesystem>
+#include <system_error>
 #include "json.hpp"
 #include "Logger.h"
+#include "L10nKeys.h"
+#include "LanguageBundle.h"
 #include <SFML/System/String.hpp>
 
 #ifndef UNTITLED23_LOCALIZATIONMANAGER_H
@@ -14,81 +28,475 @@
 using namespace nlohmann;
 using namespace std;
 #endif
+
+/**
+ * @brief Таблиця однієї мови поверх бінарного пакета (див. LanguageBundle.h).
+ * @details Байти пакета або відображені з файлу *.l10n (mmap, без жодного розбору),
+ * або зібрані в пам'яті з JSON, якщо пакета поруч немає. Шаблони в пакеті вже розбиті
+ * на сегменти й декодовані в UTF-32, тож форматування — один прохід по сегментах.
+ * Ключі з L10nKeys.h при відкритті розкладаються у плоский масив byId, тож пошук
+ * за L10nId — це індекс у масиві без хешування та порівняння рядків.
+ */
+struct LanguageTable {
+    using Entry = LanguageBundle::Entry;
+    using Segment = LanguageBundle::Segment;
+
+    static constexpr uint32_t NONE = UINT32_MAX;
+
+    LanguageBundle::MappedFile mapping; ///< Відображений файл пакета
+    string owned;                       ///< Або пакет, зібраний з JSON
+    LanguageBundle::View view;
+    vector<uint32_t> byId;              ///< L10nId -> номер запису (або NONE)
+
+    /**
+     * @brief Відкриває пакет з файлу *.l10n.
+     * @return false, якщо файлу немає або він пошкоджений.
+     */
+    bool openMapped(const string& path) {
+        if (!mapping.open(path)) return false;
+        if (!view.open(mapping.bytes(), mapping.size())) {
+            mapping.close();
+            return false;
+        }
+        resolveIds();
+        return true;
+    }
+
+    /**
+     * @brief Відкриває пакет, зібраний у пам'яті (LanguageBundle::Builder::build()).
+     */
+    bool openOwned(string bytes) {
+        owned = std::move(bytes);
+        if (!view.open(owned.data(), owned.size())) return false;
+        resolveIds();
+        return true;
+    }
+
+    const Entry* find(const string& key) const { return view.find(key); }
+
+    const Entry* find(L10nId id) const {
+        uint32_t e = id.index < byId.size() ? byId[id.index] : NONE;
+        return e == NONE ? nullptr : &view.entry(e);
+    }
+
+private:
+    void resolveIds() {
+        byId.assign(L10nKeys::COUNT, NONE);
+        for (size_t i = 0; i < L10nKeys::COUNT; ++i) {
+            const Entry* e = view.find(L10nKeys::names[i]);
+            if (e) byId[i] = (uint32_t)view.indexOf(e);
+        }
+    }
+};
+
+/**
+ * @brief Готовий до показу мовний пакет.
+ * @details Після побудови не змінюється, тож його можна будувати на одному потоці,
+ * а читати на іншому — менеджер лише атомарно підміняє вказівник на поточний пакет.
+ */
+struct LanguagePack {
+    string code;
+    LanguageTable table;
+};
+
 /**
  * @brief Менеджер локалізації (Singleton).
+ * @details Поточна мова — незмінний LanguagePack за атомарним shared_ptr. Файли мов
+ * розбирає фоновий потік (loadLanguageAsync, preloadLanguages), а готовий пакет
+ * публікується однією атомарною заміною вказівника, тож кадр ніколи не чекає на диск чи JSON.
+ * Кожна публікація збільшує getGeneration() — за ним UI дізнається, що час оновити тексти.
+ * Уже розібрані пакети зберігаються, тож повторне перемикання миттєве.
  */
 
 class LocalizationManager {
+public:
+    static constexpr size_t FORMATTED_CACHE_LIMIT = 512; ///< Після цього кеш форматованих рядків очищується
+    using PackPtr = shared_ptr<const LanguagePack>;
+
 private:
-    nlohmann::json translations;
-    LocalizationManager() {}
+    atomic<PackPtr> current;       ///< Опублікована мова
+    atomic<uint64_t> generation{0}; ///< Скільки разів публікували мову
 
-public:
-    LocalizationManager(const LocalizationManager&) = delete;
-    LocalizationManager& operator=(const LocalizationManager&) = delete;
+    // Кеш форматованих рядків належить потоку UI
+    unordered_map<string, sf::String> formattedCache; ///< (запис, аргументи) -> готовий рядок
+    PackPtr cachedPack;                               ///< Пакет, з якого зібрано кеш
 
-    static LocalizationManager& getInstance() {
-        static LocalizationManager instance;
-        return instance;
+    // Фоновий завантажувач; усе нижче захищене loaderMutex
+    mutex loaderMutex;
+    condition_variable loaderWake;
+    condition_variable loaderIdle;
+    deque<string> loaderQueue;     ///< Мови, які треба розібрати
+    map<string, PackPtr> packs;    ///< Уже розібрані мови
+    string wanted;                 ///< Остання мова, яку попросили показати
+    bool loaderBusy = false;
+    bool loaderStop = false;
+    thread loader;
+
+    LocalizationManager() {
+        Logger::getInstance(); // Логер має пережити потік завантажувача
     }
 
-    bool loadLanguage(const string& lang_code) {
+    ~LocalizationManager() {
+        {
+            lock_guard<mutex> lock(loaderMutex);
+            loaderStop = true;
+        }
+        loaderWake.notify_all();
+        if (loader.joinable()) loader.join();
+    }
+
+    /**
+     * @brief Текстове подання одного аргументу без stringstream.
+     * @details Числа пишуться у вбудований буфер через to_chars, рядки лише посилаються.
+     * Вивід збігається з колишнім stringstream: char — символ, а не код,
+     * дробові — як %g з 6 значущими цифрами (типова точність ostream).
+     */
+    struct ArgText {
+        char digits[32];
+        string_view view;
+
+        ArgText() = default;
+        ArgText(const ArgText&) = delete;
+        ArgText& operator=(const ArgText&) = delete;
+
+        template<typename T>
+        void set(const T& value) {
+            if constexpr (is_same_v<T, bool>) {
+                view = value ? "1" : "0";
+            } else if constexpr (is_same_v<T, char> || is_same_v<T, signed char> || is_same_v<T, unsigned char>) {
+                digits[0] = (char)value;
+                view = string_view(digits, 1);
+            } else if constexpr (is_array_v<T>) {
+                view = string_view(value); // Рядковий літерал не буває нульовим
+            } else if constexpr (is_same_v<T, const char*> || is_same_v<T, char*>) {
+                view = value ? string_view(value) : string_view(); // ostream з nullptr нічого не пише
+            } else if constexpr (is_floating_point_v<T>) {
+                auto result = to_chars(digits, digits + sizeof(digits), value, chars_format::general, 6);
+                view = string_view(digits, (size_t)(result.ptr - digits));
+            } else if constexpr (is_integral_v<T>) {
+                auto result = to_chars(digits, digits + sizeof(digits), value);
+                view = string_view(digits, (size_t)(result.ptr - digits));
+            } else if constexpr (is_convertible_v<const T&, string_view>) {
+                view = string_view(value);
+            } else {
+                // Рідкісні типи (наприклад, sf::String) — через потік, як раніше
+                owned = (stringstream{} << value).str();
+                view = owned;
+            }
+        }
+
+    private:
+        string owned;
+    };
+
+    /**
+     * @brief Буфер форматування, що перевикористовується між викликами.
+     */
+    static LanguageBundle::U32String& formatBuffer() {
+        thread_local LanguageBundle::U32String buffer;
+        return buffer;
+    }
+
+    /**
+     * @brief Буфер для ключа кешу (номер запису + тексти аргументів).
+     */
+    static string& cacheKeyBuffer() {
+        thread_local string buffer;
+        return buffer;
+    }
+
+    /**
+     * @brief Перший наявний файл: name у робочій теці, інакше assets/name (або "").
+     */
+    static string findLanguageFile(const string& name) {
+        error_code error;
+        if (filesystem::is_regular_file(name, error)) return name;
+        if (filesystem::is_regular_file("assets/" + name, error)) return "assets/" + name;
+        return string();
+    }
+
+    /**
+     * @brief Чи пакет старіший за JSON, з якого його мали зібрати (JSON відредаговано після збирання).
+     */
+    static bool isStale(const string& bundlePath, const string& jsonPath) {
+        if (jsonPath.empty()) return false;
+        error_code bundleError, jsonError;
+        auto bundleTime = filesystem::last_write_time(bundlePath, bundleError);
+        auto jsonTime = filesystem::last_write_time(jsonPath, jsonError);
+        return !bundleError && !jsonError && bundleTime < jsonTime;
+    }
+
+    /**
+     * @brief Відкриває мову: пакет *.l10n, якщо він є і не старіший за JSON, інакше JSON.
+     * @return Готовий пакет або nullptr, якщо файл не відкрився чи пошкоджений.
+     */
+    static PackPtr buildPack(const string& lang_code) {
+        auto pack = make_shared<LanguagePack>();
+        pack->code = lang_code;
         string filename = lang_code + ".json";
-        ifstream file(filename);
-        if (!file.is_open()) {
-            file.clear();
-            file.open("assets/" + filename);
+        string jsonPath = findLanguageFile(filename);
+
+        // Зібраний під час збирання пакет відображається як є — без JSON.
+        // Якщо JSON змінили пізніше, пакет застарів — тоді читаємо JSON, а не старі рядки
+        string bundleName = lang_code + ".l10n";
+        for (const string& bundlePath : {bundleName, "assets/" + bundleName}) {
+            if (isStale(bundlePath, jsonPath)) {
+                LOG_WARN("Language bundle " + bundlePath + " is older than " + jsonPath + "; using JSON");
+                continue;
+            }
+            if (pack->table.openMapped(bundlePath)) return pack;
         }
+
+        ifstream file;
+        if (!jsonPath.empty()) file.open(jsonPath);
         if (!file.is_open()) {
             LOG_ERR("Could not open language file: " + filename);
-            return false;
+            return nullptr;
         }
+        nlohmann::json translations;
         try {
             translations = nlohmann::json::parse(file);
         } catch (json::parse_error& e) {
             LOG_ERR("Error parsing JSON: " + string(e.what()));
-            return false;
+            return nullptr;
         }
-        LOG_INFO("Language loaded: " + lang_code);
-        return true;
+
+        // Пакета немає — збираємо такий самий у пам'яті
+        LanguageBundle::Builder builder;
+        for (auto it = translations.begin(); it != translations.end(); ++it) {
+            if (it->is_string()) builder.add(it.key(), it->get<string>());
+        }
+        if (!pack->table.openOwned(builder.build())) {
+            LOG_ERR("Could not build language table: " + lang_code);
+            return nullptr;
+        }
+        return pack;
+    }
+
+    /**
+     * @brief Робить пакет поточним (викликається під loaderMutex).
+     */
+    void publish(const PackPtr& pack) {
+        // Шаблони для текстового виводу структурованих подій логера
+        const LanguageBundle::View& view = pack->table.view;
+        unordered_map<string, string> logTemplates;
+        logTemplates.reserve(view.size());
+        for (size_t i = 0; i < view.size(); ++i) {
+            logTemplates.emplace(view.key(view.entry(i)), view.text(view.entry(i)));
+        }
+        Logger::getInstance().setTemplates(std::move(logTemplates));
+        current.store(pack, memory_order_release);
+        generation.fetch_add(1, memory_order_release);
+        LOG_INFO("Language loaded: " + pack->code);
     }
 
+    void loaderLoop() {
+        unique_lock<mutex> lock(loaderMutex);
+        while (true) {
+            loaderWake.wait(lock, [this] { return loaderStop || !loaderQueue.empty(); });
+            if (loaderStop) return;
+            string code = std::move(loaderQueue.front());
+            loaderQueue.pop_front();
 
-    sf::String getString(const string& key) {
-        string utf8Str = "!!" + key + "!!";
+            PackPtr pack;
+            auto ready = packs.find(code);
+            if (ready != packs.end()) {
+                pack = ready->second;
+            } else {
+                loaderBusy = true;
+                lock.unlock();
+                pack = buildPack(code); // Диск і JSON — без блокування
+                lock.lock();
+                loaderBusy = false;
+                if (pack) packs[code] = pack;
+            }
+            // Поки розбирали, користувач міг обрати іншу мову — публікуємо лише останню
+            if (pack && code == wanted && current.load(memory_order_relaxed) != pack) publish(pack);
+            if (loaderQueue.empty()) loaderIdle.notify_all();
+        }
+    }
+
+    /**
+     * @brief Ставить мову в чергу завантажувача (викликається під loaderMutex).
+     */
+    void enqueue(const string& lang_code) {
+        if (!loader.joinable()) loader = thread(&LocalizationManager::loaderLoop, this);
+        loaderQueue.push_back(lang_code);
+        loaderWake.notify_one();
+    }
+
+public:
+    LocalizationManager(const LocalizationManager&) = delete;
+    LocalizationManager& operator=(const LocalizationManager&) = delete;
+
+    static LocalizationManager& getInstance() {
+        static LocalizationManager instance;
+        return instance;
+    }
+
+    /**
+     * @brief Синхронно завантажує мову на потоці, що викликає (старт гри, тести).
+     * @return false, якщо файл не знайдено чи він пошкоджений — тоді мова не змінюється.
+     */
+    bool loadLanguage(const string& lang_code) {
+        PackPtr pack = buildPack(lang_code);
+        if (!pack) return false;
+        lock_guard<mutex> lock(loaderMutex);
+        packs[lang_code] = pack;
+        wanted = lang_code;
+        publish(pack);
+        formattedCache.clear();
+        cachedPack.reset();
+        return true;
+    }
+
+    /**
+     * @brief Перемикає мову без очікування: готовий пакет публікується одразу,
+     * інакше файл розбирається у фоні й публікується, коли буде готовий.
+     * @details Помилка завантаження лише логується — поточна мова лишається.
+     */
+    void loadLanguageAsync(const string& lang_code) {
+        lock_guard<mutex> lock(loaderMutex);
+        wanted = lang_code;
+        auto ready = packs.find(lang_code);
+        if (ready != packs.end()) {
+            if (current.load(memory_order_relaxed) != ready->second) publish(ready->second);
+            return;
+        }
+        enqueue(lang_code);
+    }
 
-        if (translations.contains(key)) {
-            utf8Str = translations[key].get<string>();
+    /**
+     * @brief Розбирає мови у фоні наперед, не змінюючи поточну.
+     */
+    void preloadLanguages(const vector<string>& lang_codes) {
+        lock_guard<mutex> lock(loaderMutex);
+        for (const string& code : lang_codes) {
+            if (packs.find(code) == packs.end()) enqueue(code);
         }
+    }
+
+    /**
+     * @brief Чекає, доки завантажувач розбере всі мови з черги (для тестів).
+     */
+    void waitForPendingLoads() {
+        unique_lock<mutex> lock(loaderMutex);
+        loaderIdle.wait(lock, [this] { return loaderQueue.empty() && !loaderBusy; });
+    }
 
+    /**
+     * @brief Чи розбирає завантажувач якусь мову просто зараз (або має їх у черзі).
+     */
+    bool isLoading() {
+        lock_guard<mutex> lock(loaderMutex);
+        return !loaderQueue.empty() || loaderBusy;
+    }
+
+    /**
+     * @brief Номер публікації мови: змінився — тексти інтерфейсу треба оновити.
+     */
+    uint64_t getGeneration() const { return generation.load(memory_order_acquire); }
 
-        return sf::String::fromUtf8(utf8Str.begin(), utf8Str.end());
+    /**
+     * @brief Код поточної мови ("" до першого завантаження).
+     */
+    string getLanguage() const {
+        PackPtr pack = current.load(memory_order_acquire);
+        return pack ? pack->code : string();
     }
 
+    /**
+     * @brief Рядок за ключем, відомим під час компіляції: `getString(l10nKey("game_title"))`.
+     */
+    sf::String getString(L10nId id) {
+        PackPtr pack = current.load(memory_order_acquire);
+        if (!pack) return missing(L10nKeys::names[id.index]);
+        return text(*pack, pack->table.find(id), L10nKeys::names[id.index]);
+    }
+
+    /**
+     * @brief Рядок за довільним ключем (двійковий пошук у відсортованих записах пакета).
+     */
+    sf::String getString(const string& key) {
+        PackPtr pack = current.load(memory_order_acquire);
+        if (!pack) return missing(key);
+        return text(*pack, pack->table.find(key), key);
+    }
+
+    template<typename... Args>
+    sf::String getFormattedString(L10nId id, const Args&... args) {
+        PackPtr pack = current.load(memory_order_acquire);
+        if (!pack) return missing(L10nKeys::names[id.index]);
+        return format(pack, pack->table.find(id), L10nKeys::names[id.index], args...);
+    }
 
     template<typename... Args>
     sf::String getFormattedString(const string& key, const Args&... args) {
-        string format_str;
-        if (translations.contains(key)) {
-            format_str = translations[key].get<string>();
-        } else {
-            return sf::String("!!" + key + "!!");
+        PackPtr pack = current.load(memory_order_acquire);
+        if (!pack) return missing(key);
+        return format(pack, pack->table.find(key), key, args...);
+    }
+
+    /**
+     * @brief Скільки відформатованих рядків зараз у кеші (для тестів).
+     */
+    size_t formattedCacheSize() const { return formattedCache.size(); }
+
+private:
+    static sf::String missing(string_view key) {
+        string text = "!!" + string(key) + "!!";
+        return sf::String::fromUtf8(text.begin(), text.end());
+    }
+
+    static sf::String text(const LanguagePack& pack, const LanguageTable::Entry* entry, string_view key) {
+        if (!entry) return missing(key);
+        const uint32_t* u32 = pack.table.view.u32(entry->u32Offset);
+        return sf::String::fromUtf32(u32, u32 + entry->u32Length); // Лише копія, без декодування
+    }
+
+    /**
+     * @brief Форматує запис; однакові (запис, аргументи) беруться з кешу.
+     * @details Кеш прив'язаний до пакета, з якого будувався, і очищується при першому
+     * виклику з іншим пакетом. Ключ кешу збирається в буфері, що перевикористовується,
+     * тож повторний кадр меню нічого не декодує й не форматує. Результат повертається
+     * копією sf::String, тож одне виділення пам'яті на виклик лишається.
+     */
+    template<typename... Args>
+    sf::String format(const PackPtr& pack, const LanguageTable::Entry* entry, string_view key, const Args&... args) {
+        if (!entry) return missing(key);
+        const LanguageBundle::View& view = pack->table.view;
+        if (cachedPack != pack) { // Мову змінили — старі рядки вже не потрібні
+            formattedCache.clear();
+            cachedPack = pack;
         }
 
-        vector<std::string> string_args;
-        ( (string_args.push_back( (stringstream{} << args).str() )), ...);
+        ArgText argTexts[sizeof...(Args) + 1];
+        size_t n = 0;
+        ((argTexts[n++].set(args)), ...);
+        (void)n;
 
+        string& cacheKey = cacheKeyBuffer();
+        uint32_t entryIndex = (uint32_t)view.indexOf(entry);
+        cacheKey.assign((const char*)&entryIndex, sizeof(entryIndex));
+        for (size_t i = 0; i < sizeof...(Args); ++i) {
+            cacheKey += argTexts[i].view;
+            cacheKey += '\x1f';
+        }
+        auto cached = formattedCache.find(cacheKey);
+        if (cached != formattedCache.end()) return cached->second;
 
-        for (size_t i = 0; i < string_args.size(); ++i) {
-            string placeholder = "{" + to_string(i) + "}";
-            size_t pos = format_str.find(placeholder);
-            while (pos != string::npos) {
-                format_str.replace(pos, placeholder.length(), string_args[i]);
-                pos = format_str.find(placeholder, pos + string_args[i].length());
+        LanguageBundle::U32String& out = formatBuffer();
+        out.clear();
+        for (uint32_t s = 0; s < entry->segmentCount; ++s) {
+            const LanguageTable::Segment& segment = view.segment(entry->firstSegment + s);
+            if (segment.arg >= 0 && (size_t)segment.arg < sizeof...(Args)) {
+                LanguageBundle::appendUtf32(out, argTexts[segment.arg].view);
+            } else {
+                out.append(view.u32(segment.u32Offset), segment.u32Length);
             }
         }
 
-
-        return sf::String::fromUtf8(format_str.begin(), format_str.end());
+        if (formattedCache.size() >= FORMATTED_CACHE_LIMIT) formattedCache.clear();
+        return formattedCache.emplace(cacheKey, sf::String(out)).first->second;
     }
-};
\ No newline at end of file
+};
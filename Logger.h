@@ -7,6 +7,28 @@
 #include <ctime>
 #include <iomanip>
 #include <sstream>
+#include <atomic>
+#include <thread>
+#include <condition_variable>
+#include <memory>
+#include <cstdint>
+#include <vector>
+#include <unordered_map>
+#include <initializer_list>
+#include <csignal>
+#include <cerrno>
+#include <cstdio>
+#if defined(_WIN32) || defined(_WIN64)
+#include <io.h>
+#include <fcntl.h>
+#include <sys/stat.h>
+#else
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+#include "BinaryLog.h"
+#include "FlightRecorder.h"
+#include "L10nKeys.h"
 
 /**
  * @brief Рівні важливості повідомлень логування.
@@ -18,26 +40,499 @@ enum class LogLevel {
     Error, ///< Критична помилка
     Debug ///< Технічна інформація для відладки
 };
+
+/**
+ * @brief Вага рівня для фільтрації: Debug < Info < Warning < Error.
+ */
+constexpr int logSeverity(LogLevel level) {
+    switch (level) {
+        case LogLevel::Debug: return 0;
+        case LogLevel::Info: return 1;
+        case LogLevel::Warning: return 2;
+        case LogLevel::Error: return 3;
+    }
+    return 3;
+}
+
+/**
+ * @brief Мінімальна вага рівня, що взагалі компілюється (0 = Debug ... 3 = Error).
+ * @details У релізній збірці (NDEBUG) за замовчуванням 1: виклики LOG_DEBUG разом
+ * з побудовою їхніх рядків вилучаються компілятором. Можна перевизначити через -DLOG_MIN_LEVEL=N.
+ */
+#ifndef LOG_MIN_LEVEL
+#ifdef NDEBUG
+#define LOG_MIN_LEVEL 1
+#else
+#define LOG_MIN_LEVEL 0
+#endif
+#endif
+
+/**
+ * @brief Формат виводу логера.
+ */
+enum class LogFormat {
+    Text,  ///< Текст у game_log.txt і консоль (за замовчуванням)
+    Binary, ///< Компактні записи у game_log.bin (розкодовує tools/logdecode)
+    Off     ///< Без файлу і консолі: події лишаються тільки у FlightRecorder
+};
+
 /**
  * @brief Клас для запису логів гри у файл та консоль.
  * @details Реалізований як Thread-safe Singleton.
+ * Запис асинхронний: log() лише кладе повідомлення в обмежений кільцевий буфер
+ * (MPSC, без блокувань — один CAS на повідомлення), а окремий потік-письменник
+ * пачками форматує і виводить їх у game_log.txt та консоль. Пачка скидається
+ * за таймером (FLUSH_INTERVAL), на flush() і при завершенні програми.
+ * Тож час ходу гравця не залежить від швидкості терміналу чи диска.
+ * Якщо буфер переповнений, повідомлення відкидається, а письменник потім
+ * повідомляє, скільки записів втрачено.
+ *
+ * Крім тексту, логер приймає структуровані події (LOG_EVENT): id повідомлення
+ * плюс до MAX_ARGS цілих аргументів чи інтернованих рядків. У режимі LogFormat::Binary
+ * такі події пишуться у game_log.bin без жодного форматування, у текстовому режимі
+ * письменник підставляє аргументи в шаблон (див. setTemplates).
+ *
+ * Кожне повідомлення, що пройшло фільтри рівнів, також потрапляє у FlightRecorder —
+ * кільце останніх подій у пам'яті, яке можна вивантажити гарячою клавішею,
+ * з обробника аварій (installCrashHandler) або з тесту, навіть коли вивід вимкнено.
+ * Гаряча клавіша і тести отримують текст (dumpFlightRecorder), а обробник аварій пише
+ * сирі записи у форматі game_log.bin (writeCrashDump) — їх розкодовує tools/logdecode.
  */
 class Logger {
+public:
+    static constexpr size_t QUEUE_CAPACITY = 4096; ///< Розмір кільцевого буфера (степінь двійки)
+    static constexpr std::chrono::milliseconds FLUSH_INTERVAL{50}; ///< Як часто письменник прокидається
+    static constexpr size_t MAX_ARGS = 6; ///< Максимум аргументів однієї події
+    static constexpr uint32_t NOT_INTERNED = 0; ///< Id 0 зарезервовано: "рядок ще не інтерновано"
+    static constexpr size_t CRASH_STRINGS_SIZE = 64 * 1024; ///< Місце під рядки для аварійного дампу
+
 private:
+    static_assert((QUEUE_CAPACITY & (QUEUE_CAPACITY - 1)) == 0, "QUEUE_CAPACITY must be a power of two");
+
+    /**
+     * @brief Що лежить у комірці: текстовий рядок, структурована подія чи новий інтернований рядок.
+     */
+    enum class RecordKind : uint8_t { Text, Event, String };
+
+    /**
+     * @brief Комірка кільцевого буфера (черга Вʼюкова).
+     * @details sequence == позиція: комірка вільна для запису;
+     * sequence == позиція + 1: у комірці лежить готове повідомлення.
+     */
+    struct Slot {
+        std::atomic<size_t> sequence{0};
+        RecordKind kind = RecordKind::Text;
+        LogLevel level = LogLevel::Info;
+        std::chrono::system_clock::time_point time;
+        std::string message;    ///< Текст (Text) або вміст рядка (String)
+        uint32_t messageId = 0; ///< Id повідомлення (Event) або рядка (String)
+        uint8_t argc = 0;
+        LogArg args[MAX_ARGS];
+    };
+
     std::ofstream logFile;
-    std::mutex logMutex;
+    std::unique_ptr<Slot[]> slots;
+    alignas(64) std::atomic<size_t> enqueuePos{0}; ///< Спільна позиція для продюсерів
+    alignas(64) size_t dequeuePos = 0;             ///< Належить лише письменнику
+    std::atomic<size_t> writtenPos{0};             ///< Усе до цієї позиції вже виведено
+    std::atomic<size_t> dropped{0};                ///< Відкинуто через переповнення
+    std::atomic<bool> stopping{false};
 
-    Logger() {
-        logFile.open("game_log.txt", std::ios::out | std::ios::trunc);
-        if (!logFile.is_open()) {
-            std::cerr << "[CRITICAL ERROR] Cannot open game_log.txt!" << std::endl;
+    static inline std::atomic<int> runtimeMinSeverity{0}; ///< Поріг, що змінюється під час гри
+
+    std::atomic<LogFormat> format{LogFormat::Text};
+
+    std::mutex internMutex; ///< Захищає таблицю інтернованих рядків
+    std::unordered_map<std::string, uint32_t> internIds;
+    std::vector<std::string> internById; ///< Зворотна таблиця для вивантаження самописця
+
+    FlightRecorder recorder;
+
+    /// Рядки для аварійного дампу — готові записи 'S' (доповнюються під internMutex).
+    /// Обробник сигналу читає перші crashStringsSize байтів без блокування.
+    uint8_t crashStrings[CRASH_STRINGS_SIZE];
+    std::atomic<size_t> crashStringsSize{0};
+    static inline std::atomic<int> crashFd{-1}; ///< Файл аварійного дампу, відкритий заздалегідь
+    std::atomic<bool> crashDumpWritten{false};
+    std::string crashPath;
+
+    std::mutex templatesMutex; ///< Захищає шаблони для текстового виводу подій
+    std::unordered_map<std::string, std::string> templates;
+
+    std::mutex wakeMutex;
+    std::condition_variable wakeCv;
+    std::thread writer;
+
+    std::time_t cachedSecond = -1; ///< Кеш форматованої мітки часу (змінює лише письменник)
+    std::string cachedStamp;
+
+    // Стан письменника (лише потік-письменник)
+    std::vector<std::string> internedText; ///< id -> рядок, у порядку появи
+    std::ofstream binaryFile;
+    bool textOpenFailed = false; ///< Не намагатися відкрити game_log.txt щопачки
+    int64_t lastMicros = 0; ///< Час попереднього бінарного запису
+
+    Logger() : slots(new Slot[QUEUE_CAPACITY]) {
+        for (size_t i = 0; i < QUEUE_CAPACITY; ++i) {
+            slots[i].sequence.store(i, std::memory_order_relaxed);
         }
+        // Порожній рядок займає id NOT_INTERNED, тож справжні рядки отримують id від 1
+        internIds.emplace(std::string(), NOT_INTERNED);
+        internById.emplace_back();
+        internedText.emplace_back();
+        // game_log.txt відкривається з першим рядком (openText), тож з LogFormat::Off файл не з'являється
+        writer = std::thread([this] { writerLoop(); });
     }
 
     ~Logger() {
+        int fd = crashFd.exchange(-1);
+        if (fd >= 0) {
+            closeFd(fd);
+            // Аварії не було — порожній файл дампу не потрібен
+            if (!crashDumpWritten.load()) std::remove(crashPath.c_str());
+        }
+        {
+            std::lock_guard<std::mutex> lock(wakeMutex);
+            stopping.store(true);
+        }
+        wakeCv.notify_one();
+        if (writer.joinable()) {
+            writer.join();
+        }
         if (logFile.is_open()) {
             logFile.close();
         }
+        if (binaryFile.is_open()) {
+            binaryFile.close();
+        }
+    }
+
+    /**
+     * @brief Займає комірку буфера і заповнює її функцією fill.
+     * @return false, якщо буфер переповнений.
+     */
+    template<typename Fill>
+    bool tryEnqueue(LogLevel level, RecordKind kind, Fill&& fill) {
+        size_t pos = enqueuePos.load(std::memory_order_relaxed);
+        for (;;) {
+            Slot& slot = slots[pos & (QUEUE_CAPACITY - 1)];
+            size_t seq = slot.sequence.load(std::memory_order_acquire);
+            intptr_t diff = (intptr_t)seq - (intptr_t)pos;
+            if (diff == 0) {
+                if (enqueuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                    slot.kind = kind;
+                    slot.level = level;
+                    slot.time = std::chrono::system_clock::now();
+                    fill(slot);
+                    slot.sequence.store(pos + 1, std::memory_order_release);
+                    return true;
+                }
+            } else if (diff < 0) {
+                return false;
+            } else {
+                pos = enqueuePos.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    static int openFd(const std::string& path) {
+#if defined(_WIN32) || defined(_WIN64)
+        return _open(path.c_str(), _O_WRONLY | _O_CREAT | _O_TRUNC | _O_BINARY, _S_IREAD | _S_IWRITE);
+#else
+        return ::open(path.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+#endif
+    }
+
+    static void closeFd(int fd) {
+#if defined(_WIN32) || defined(_WIN64)
+        _close(fd);
+#else
+        ::close(fd);
+#endif
+    }
+
+    /**
+     * @brief Пише весь буфер у дескриптор (лише write(2), тож можна з обробника сигналу).
+     */
+    static bool writeFd(int fd, const void* data, size_t size) {
+        const char* p = (const char*)data;
+        while (size > 0) {
+#if defined(_WIN32) || defined(_WIN64)
+            int n = _write(fd, p, (unsigned)size);
+#else
+            ssize_t n = ::write(fd, p, size);
+            if (n < 0 && errno == EINTR) continue;
+#endif
+            if (n <= 0) return false;
+            p += n;
+            size -= (size_t)n;
+        }
+        return true;
+    }
+
+    /**
+     * @brief Обрізає файл дампу до нуля, щоб повторний дамп не дописувався до старого.
+     */
+    static bool rewindFd(int fd) {
+#if defined(_WIN32) || defined(_WIN64)
+        return _lseek(fd, 0, SEEK_SET) == 0 && _chsize(fd, 0) == 0;
+#else
+        return ::lseek(fd, 0, SEEK_SET) == 0 && ::ftruncate(fd, 0) == 0;
+#endif
+    }
+
+    /**
+     * @brief Дописує рядок у таблицю для аварійного дампу (викликається під internMutex).
+     * @details Коли місце скінчилося, рядок пропускається: logdecode покаже замість нього "?".
+     */
+    void appendCrashString(uint32_t id, const std::string& text) {
+        size_t size = crashStringsSize.load(std::memory_order_relaxed);
+        uint8_t header[21];
+        uint8_t* p = header;
+        *p++ = BinaryLog::TAG_STRING;
+        p = BinaryLog::putVarint(p, id);
+        p = BinaryLog::putVarint(p, text.size());
+        size_t headerSize = (size_t)(p - header);
+        if (CRASH_STRINGS_SIZE - size < headerSize + text.size()) return;
+        std::memcpy(crashStrings + size, header, headerSize);
+        std::memcpy(crashStrings + size + headerSize, text.data(), text.size());
+        crashStringsSize.store(size + headerSize + text.size(), std::memory_order_release);
+    }
+
+    static const char* levelTag(LogLevel level) {
+        switch (level) {
+            case LogLevel::Info: return "[INFO]";
+            case LogLevel::Warning: return "[WARN]";
+            case LogLevel::Error: return "[ERROR]";
+            case LogLevel::Debug: return "[DEBUG]";
+        }
+        return "";
+    }
+
+    static const char* levelColor(LogLevel level) {
+        switch (level) {
+            case LogLevel::Info: return "\033[32m"; // Зелений
+            case LogLevel::Warning: return "\033[33m"; // Жовтий
+            case LogLevel::Error: return "\033[31m"; // Червоний
+            case LogLevel::Debug: return "\033[36m"; // Блакитний
+        }
+        return "";
+    }
+
+    /**
+     * @brief Мітка часу "[YYYY-MM-DD HH:MM:SS] "; localtime викликається раз на секунду.
+     */
+    const std::string& stampFor(std::chrono::system_clock::time_point time) {
+        std::time_t now = std::chrono::system_clock::to_time_t(time);
+        if (now != cachedSecond) {
+            std::tm tmBuf;
+#if defined(_WIN32) || defined(_WIN64)
+            localtime_s(&tmBuf, &now);
+#else
+            localtime_r(&now, &tmBuf);
+#endif
+            std::ostringstream ss;
+            ss << "[" << std::put_time(&tmBuf, "%Y-%m-%d %H:%M:%S") << "] ";
+            cachedStamp = ss.str();
+            cachedSecond = now;
+        }
+        return cachedStamp;
+    }
+
+    void appendLine(std::string& fileBatch, std::string& consoleBatch, LogLevel level,
+                    std::chrono::system_clock::time_point time, const std::string& message) {
+        const std::string& stamp = stampFor(time);
+        fileBatch += stamp;
+        fileBatch += levelTag(level);
+        fileBatch += ' ';
+        fileBatch += message;
+        fileBatch += '\n';
+
+        consoleBatch += levelColor(level);
+        consoleBatch += stamp;
+        consoleBatch += levelTag(level);
+        consoleBatch += ' ';
+        consoleBatch += message;
+        consoleBatch += "\033[0m\n";
+    }
+
+    /**
+     * @brief Текст події: шаблон з підставленими {0}, {1}... або "ключ: арг, арг".
+     * @details Викликається з захопленим templatesMutex.
+     * @param strings Таблиця id -> інтернований рядок.
+     */
+    std::string renderEvent(uint32_t messageId, const LogArg* args, uint8_t argc,
+                            const std::vector<std::string>& strings) const {
+        static const std::string unknown = "?";
+        auto stringAt = [&](int64_t id) -> const std::string& {
+            return (id >= 0 && (size_t)id < strings.size()) ? strings[(size_t)id] : unknown;
+        };
+        auto argText = [&](size_t n) {
+            return args[n].type == BinaryLog::ArgType::Str ? stringAt(args[n].value) : std::to_string(args[n].value);
+        };
+
+        const std::string& key = stringAt(messageId);
+        auto tpl = templates.find(key);
+        if (tpl == templates.end()) {
+            std::string text = key;
+            for (uint8_t i = 0; i < argc; ++i) {
+                text += (i == 0) ? ": " : ", ";
+                text += argText(i);
+            }
+            return text;
+        }
+
+        return BinaryLog::fillTemplate(tpl->second, argc, argText);
+    }
+
+    void putTime(std::string& out, std::chrono::system_clock::time_point time) {
+        int64_t micros = std::chrono::duration_cast<std::chrono::microseconds>(time.time_since_epoch()).count();
+        BinaryLog::putVarint(out, BinaryLog::zigzag(micros - lastMicros));
+        lastMicros = micros;
+    }
+
+    static void putString(std::string& out, uint32_t id, const std::string& text) {
+        out += (char)BinaryLog::TAG_STRING;
+        BinaryLog::putVarint(out, id);
+        BinaryLog::putVarint(out, text.size());
+        out += text;
+    }
+
+    /**
+     * @brief Кодує запис у бінарний формат (див. BinaryLog.h).
+     */
+    void appendBinary(std::string& out, const Slot& slot) {
+        switch (slot.kind) {
+            case RecordKind::String:
+                putString(out, slot.messageId, slot.message);
+                break;
+            case RecordKind::Event:
+                out += (char)BinaryLog::TAG_EVENT;
+                putTime(out, slot.time);
+                out += (char)(uint8_t)slot.level;
+                BinaryLog::putVarint(out, slot.messageId);
+                out += (char)slot.argc;
+                for (uint8_t i = 0; i < slot.argc; ++i) {
+                    out += (char)(uint8_t)slot.args[i].type;
+                    BinaryLog::putVarint(out, BinaryLog::zigzag(slot.args[i].value));
+                }
+                break;
+            case RecordKind::Text:
+                out += (char)BinaryLog::TAG_TEXT;
+                putTime(out, slot.time);
+                out += (char)(uint8_t)slot.level;
+                BinaryLog::putVarint(out, slot.message.size());
+                out += slot.message;
+                break;
+        }
+    }
+
+    /**
+     * @brief Відкриває game_log.txt перед першим текстовим рядком.
+     */
+    void openText() {
+        logFile.open("game_log.txt", std::ios::out | std::ios::trunc);
+        if (!logFile.is_open()) {
+            textOpenFailed = true;
+            std::cerr << "[CRITICAL ERROR] Cannot open game_log.txt!" << std::endl;
+        }
+    }
+
+    /**
+     * @brief Відкриває game_log.bin і записує заголовок та всі вже відомі рядки.
+     */
+    void openBinary(std::string& binaryBatch) {
+        binaryFile.open("game_log.bin", std::ios::out | std::ios::trunc | std::ios::binary);
+        if (!binaryFile.is_open()) {
+            std::cerr << "[CRITICAL ERROR] Cannot open game_log.bin!" << std::endl;
+            return;
+        }
+        binaryBatch.append(BinaryLog::MAGIC, sizeof(BinaryLog::MAGIC));
+        binaryBatch += (char)BinaryLog::VERSION;
+        for (size_t id = 0; id < internedText.size(); ++id) {
+            putString(binaryBatch, (uint32_t)id, internedText[id]);
+        }
+        lastMicros = 0;
+    }
+
+    /**
+     * @brief Забирає все, що накопичилось у буфері, і виводить однією пачкою.
+     */
+    void drain(std::string& fileBatch, std::string& consoleBatch, std::string& binaryBatch) {
+        fileBatch.clear();
+        consoleBatch.clear();
+        binaryBatch.clear();
+
+        LogFormat currentFormat = format.load(std::memory_order_relaxed);
+        bool binary = currentFormat == LogFormat::Binary;
+        bool off = currentFormat == LogFormat::Off;
+        if (binary && !binaryFile.is_open()) {
+            openBinary(binaryBatch);
+        }
+
+        size_t lost = dropped.exchange(0, std::memory_order_relaxed);
+        if (lost > 0 && !off) {
+            appendLine(fileBatch, consoleBatch, LogLevel::Warning, std::chrono::system_clock::now(),
+                       "Logger queue overflow: " + std::to_string(lost) + " messages dropped.");
+        }
+
+        std::unique_lock<std::mutex> templatesLock(templatesMutex, std::defer_lock);
+        for (;;) {
+            Slot& slot = slots[dequeuePos & (QUEUE_CAPACITY - 1)];
+            if (slot.sequence.load(std::memory_order_acquire) != dequeuePos + 1) break;
+
+            if (slot.kind == RecordKind::String) {
+                if (internedText.size() <= slot.messageId) internedText.resize(slot.messageId + 1);
+                internedText[slot.messageId] = slot.message;
+            }
+
+            if (off) {
+                // Записи, додані до вимкнення виводу, просто відкидаються
+            } else if (binary) {
+                appendBinary(binaryBatch, slot);
+            } else if (slot.kind == RecordKind::Text) {
+                appendLine(fileBatch, consoleBatch, slot.level, slot.time, slot.message);
+            } else if (slot.kind == RecordKind::Event) {
+                if (!templatesLock.owns_lock()) templatesLock.lock();
+                appendLine(fileBatch, consoleBatch, slot.level, slot.time,
+                           renderEvent(slot.messageId, slot.args, slot.argc, internedText));
+            }
+
+            slot.message.clear();
+            slot.sequence.store(dequeuePos + QUEUE_CAPACITY, std::memory_order_release);
+            ++dequeuePos;
+        }
+        if (templatesLock.owns_lock()) templatesLock.unlock();
+
+        if (!fileBatch.empty()) {
+            if (!logFile.is_open() && !textOpenFailed) openText();
+            if (logFile.is_open()) {
+                logFile.write(fileBatch.data(), (std::streamsize)fileBatch.size());
+                logFile.flush();
+            }
+            std::cout.write(consoleBatch.data(), (std::streamsize)consoleBatch.size());
+            std::cout.flush();
+        }
+        if (!binaryBatch.empty() && binaryFile.is_open()) {
+            binaryFile.write(binaryBatch.data(), (std::streamsize)binaryBatch.size());
+            binaryFile.flush();
+        }
+        writtenPos.store(dequeuePos, std::memory_order_release);
+    }
+
+    void writerLoop() {
+        std::string fileBatch;
+        std::string consoleBatch;
+        std::string binaryBatch;
+        std::unique_lock<std::mutex> lock(wakeMutex);
+        while (!stopping.load()) {
+            wakeCv.wait_for(lock, FLUSH_INTERVAL);
+            lock.unlock();
+            drain(fileBatch, consoleBatch, binaryBatch);
+            lock.lock();
+        }
+        lock.unlock();
+        drain(fileBatch, consoleBatch, binaryBatch);
     }
 
 public:
@@ -53,59 +548,291 @@ public:
     }
     /**
      * @brief Записує повідомлення у лог.
+     * @details Не чекає на вивід: повідомлення потрапляє в буфер, а виводить його потік-письменник.
      * @param level Рівень важливості повідомлення.
      * @param message Текст повідомлення.
      */
-    void log(LogLevel level, const std::string& message) {
-        std::lock_guard<std::mutex> lock(logMutex);
+    void log(LogLevel level, std::string message) {
+        recorder.recordText((uint8_t)level, message);
+        if (format.load(std::memory_order_relaxed) == LogFormat::Off) return;
 
-        auto now = std::chrono::system_clock::to_time_t(std::chrono::system_clock::now());
-        std::tm tmBuf;
-#if defined(_WIN32) || defined(_WIN64)
-        localtime_s(&tmBuf, &now);
-#else
-        localtime_r(&now, &tmBuf);
-#endif
+        auto fill = [&](Slot& slot) { slot.message = std::move(message); };
+        if (!tryEnqueue(level, RecordKind::Text, fill)) {
+            dropped.fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+
+    /**
+     * @brief Записує структуровану подію (без форматування на виклику).
+     * @param level Рівень важливості.
+     * @param messageId Id ключа повідомлення з intern().
+     * @param args Аргументи (зайві понад MAX_ARGS відкидаються).
+     */
+    void event(LogLevel level, uint32_t messageId, std::initializer_list<LogArg> args) {
+        uint8_t argc = (uint8_t)std::min(args.size(), MAX_ARGS);
+        recorder.recordEvent((uint8_t)level, messageId, args.begin(), argc);
+        if (format.load(std::memory_order_relaxed) == LogFormat::Off) return;
 
-        std::string levelStr;
-        std::string colorCode = "";
-        std::string resetCode = "\033[0m";
+        auto fill = [&](Slot& slot) {
+            slot.messageId = messageId;
+            slot.argc = argc;
+            std::copy(args.begin(), args.begin() + argc, slot.args);
+        };
+        if (!tryEnqueue(level, RecordKind::Event, fill)) {
+            dropped.fetch_add(1, std::memory_order_relaxed);
+        }
+    }
 
+    /**
+     * @brief Інтернує рядок (ключ L10N, ім'я сутності) і повертає його id.
+     * @details Новий рядок один раз передається письменнику, далі події посилаються
+     * на нього лише числом. Повторний виклик для того самого рядка повертає той самий id.
+     */
+    static uint32_t intern(const std::string& text) {
+        Logger& logger = getInstance();
+        std::lock_guard<std::mutex> lock(logger.internMutex);
+        auto it = logger.internIds.find(text);
+        if (it != logger.internIds.end()) return it->second;
 
-        switch(level) {
-            case LogLevel::Info:
-                levelStr = "[INFO]";
-                colorCode = "\033[32m"; // Зелений
-                break;
-            case LogLevel::Warning:
-                levelStr = "[WARN]";
-                colorCode = "\033[33m"; // Жовтий
-                break;
-            case LogLevel::Error:
-                levelStr = "[ERROR]";
-                colorCode = "\033[31m"; // Червоний
-                break;
-            case LogLevel::Debug:
-                levelStr = "[DEBUG]";
-                colorCode = "\033[36m"; // Блакитний
-                break;
+        uint32_t id = (uint32_t)logger.internIds.size();
+        logger.internIds.emplace(text, id);
+        logger.internById.push_back(text);
+        logger.appendCrashString(id, text);
+        // Рядок не можна загубити: події з цим id декодуються лише після нього
+        auto fill = [&](Slot& slot) {
+            slot.message = text;
+            slot.messageId = id;
+        };
+        while (!logger.tryEnqueue(LogLevel::Debug, RecordKind::String, fill) && !logger.stopping.load()) {
+            logger.wakeCv.notify_one();
+            std::this_thread::yield();
         }
+        return id;
+    }
 
-        std::stringstream ss;
-        ss << "[" << std::put_time(&tmBuf, "%Y-%m-%d %H:%M:%S") << "] "
-           << levelStr << " " << message;
+    /**
+     * @brief Скільки рядків інтерновано (разом із зарезервованим порожнім).
+     */
+    static size_t internedCount() {
+        Logger& logger = getInstance();
+        std::lock_guard<std::mutex> lock(logger.internMutex);
+        return logger.internById.size();
+    }
 
-        std::string finalLog = ss.str();
+    /**
+     * @brief Інтернує рядок при першому зверненні і запам'ятовує id у cache.
+     * @details Для імен сутностей: їх інтернують не при створенні, а лише коли подія
+     * з ними справді пише лог (аргументи LOG_EVENT обчислюються тільки тоді).
+     * Спавн орди з вимкненим логом не торкається internMutex і не росте таблиця рядків.
+     * @param cache Місце для id; NOT_INTERNED означає "ще не інтерновано".
+     */
+    static uint32_t internCached(uint32_t& cache, const std::string& text) {
+        if (cache == NOT_INTERNED) cache = intern(text);
+        return cache;
+    }
 
-        if (logFile.is_open()) {
-            logFile << finalLog << std::endl;
+    /**
+     * @brief Останні події з самописця у вигляді текстових рядків (від найстарішої).
+     */
+    std::vector<std::string> recentEvents() {
+        std::vector<FlightRecorder::Entry> entries = recorder.snapshot();
+        std::vector<std::string> lines;
+        lines.reserve(entries.size());
+
+        std::lock_guard<std::mutex> internLock(internMutex);
+        std::lock_guard<std::mutex> templatesLock(templatesMutex);
+        for (const FlightRecorder::Entry& e : entries) {
+            std::string line = "[" + BinaryLog::formatTime(e.micros) + "] [" + BinaryLog::levelName(e.level) + "] ";
+            if (e.isEvent) {
+                line += renderEvent(e.messageId, e.args, e.argc, internById);
+            } else {
+                line.append(e.text, e.textLength);
+            }
+            lines.push_back(std::move(line));
+        }
+        return lines;
+    }
+
+    /**
+     * @brief Вивантажує самописець у потік.
+     */
+    void dumpFlightRecorder(std::ostream& out) {
+        std::vector<std::string> lines = recentEvents();
+        out << "=== Flight recorder: last " << lines.size() << " of "
+            << recorder.totalRecorded() << " events ===\n";
+        for (const std::string& line : lines) out << line << '\n';
+        out.flush();
+    }
+
+    /**
+     * @brief Вивантажує самописець у текстовий файл (гаряча клавіша, тест).
+     * @return false, якщо файл не вдалося відкрити.
+     */
+    bool dumpFlightRecorder(const std::string& path) {
+        std::ofstream out(path, std::ios::out | std::ios::trunc);
+        if (!out.is_open()) return false;
+        dumpFlightRecorder(out);
+        return true;
+    }
+
+    /**
+     * @brief Пише самописець у файл аварійного дампу у форматі game_log.bin.
+     * @details Безпечна для обробника сигналу: без блокувань, без виділення пам'яті,
+     * лише write(2) у дескриптор, відкритий у installCrashHandler. Рядки беруться з окремої
+     * копії таблиці інтернування, тож дамп розкодовує tools/logdecode.
+     * @param sig Номер сигналу; якщо не 0, наприкінці додається запис "Crash: signal N".
+     * @return false, якщо обробник не встановлено або запис не вдався.
+     */
+    bool writeCrashDump(int sig = 0) {
+        int fd = crashFd.load();
+        if (fd < 0 || !rewindFd(fd)) return false;
+
+        uint8_t buffer[4096];
+        size_t used = 0;
+        std::memcpy(buffer, BinaryLog::MAGIC, sizeof(BinaryLog::MAGIC));
+        buffer[sizeof(BinaryLog::MAGIC)] = BinaryLog::VERSION;
+        bool ok = writeFd(fd, buffer, sizeof(BinaryLog::MAGIC) + 1) &&
+                  writeFd(fd, crashStrings, crashStringsSize.load(std::memory_order_acquire));
+
+        int64_t lastMicros = 0;
+        auto put = [&](const FlightRecorder::Entry& e) {
+            if (sizeof(buffer) - used < FlightRecorder::MAX_RECORD_SIZE) {
+                ok = writeFd(fd, buffer, used) && ok;
+                used = 0;
+            }
+            used += FlightRecorder::encode(e, lastMicros, buffer + used);
+        };
+        recorder.forEachRecent(put);
+
+        if (sig != 0) {
+            FlightRecorder::Entry crash;
+            crash.micros = FlightRecorder::nowMicros();
+            crash.level = (uint8_t)LogLevel::Error;
+            const char prefix[] = "Crash: signal ";
+            std::memcpy(crash.text, prefix, sizeof(prefix) - 1);
+            size_t length = sizeof(prefix) - 1;
+            char digits[12];
+            size_t count = 0;
+            for (unsigned v = (unsigned)(sig < 0 ? -sig : sig); count == 0 || v > 0; v /= 10) {
+                digits[count++] = (char)('0' + v % 10);
+            }
+            if (sig < 0) crash.text[length++] = '-';
+            while (count > 0) crash.text[length++] = digits[--count];
+            crash.textLength = (uint8_t)length;
+            put(crash);
         }
+        ok = writeFd(fd, buffer, used) && ok;
+        crashDumpWritten.store(true);
+        return ok;
+    }
 
-        std::cout << colorCode << finalLog << resetCode << std::endl;
+    /**
+     * @brief Відкриває файл дампу і ставить обробник SIGSEGV/SIGABRT/SIGFPE/SIGILL.
+     * @details Файл відкривається тут, бо в обробнику сигналу не можна ні виділяти пам'ять,
+     * ні брати блокування; сам обробник лише викликає writeCrashDump. Після запису сигнал
+     * повторюється зі стандартною дією, тож процес завершується як і раніше.
+     * Якщо аварії не було, порожній файл видаляється при завершенні.
+     * Розкодувати дамп: logdecode crash_flight_recorder.bin [--lang assets/en.json].
+     */
+    static void installCrashHandler(const std::string& path = "crash_flight_recorder.bin") {
+        Logger& logger = getInstance();
+        int fd = openFd(path);
+        if (fd < 0) {
+            std::cerr << "[CRITICAL ERROR] Cannot open " << path << "!" << std::endl;
+            return;
+        }
+        int old = crashFd.exchange(fd);
+        if (old >= 0) closeFd(old);
+        logger.crashPath = path;
+        logger.crashDumpWritten.store(false);
+        for (int sig : {SIGSEGV, SIGABRT, SIGFPE, SIGILL}) {
+            std::signal(sig, onCrashSignal);
+        }
+    }
+
+    /**
+     * @brief Вмикає текстовий або бінарний вивід (перемикання відбувається на наступній пачці).
+     * @details LogFormat::Off вимикає файл і консоль; самописець працює далі.
+     */
+    void setFormat(LogFormat newFormat) { format.store(newFormat, std::memory_order_relaxed); }
+    LogFormat getFormat() const { return format.load(std::memory_order_relaxed); }
+
+    /**
+     * @brief Шаблони для текстового виводу подій: ключ -> "{0} takes {1} damage!".
+     * @details Зазвичай це таблиця поточної мови з LocalizationManager.
+     */
+    void setTemplates(std::unordered_map<std::string, std::string> newTemplates) {
+        std::lock_guard<std::mutex> lock(templatesMutex);
+        templates = std::move(newTemplates);
+    }
+
+    /**
+     * @brief Чи пройде повідомлення цього рівня фільтри (одне атомарне читання).
+     * @details Не створює логер, тож перевірку можна робити до побудови повідомлення.
+     */
+    static bool isEnabled(LogLevel level) {
+        return logSeverity(level) >= runtimeMinSeverity.load(std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Встановлює мінімальний рівень під час виконання (нижчі рівні пропускаються).
+     * @details Рівні, вилучені LOG_MIN_LEVEL під час компіляції, так не повернути.
+     */
+    static void setLevel(LogLevel level) {
+        runtimeMinSeverity.store(logSeverity(level), std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Блокує, доки всі вже додані повідомлення не будуть виведені.
+     * @details Для тестів, обробника аварій і перед виходом з гри.
+     */
+    void flush() {
+        size_t target = enqueuePos.load(std::memory_order_acquire);
+        while (writtenPos.load(std::memory_order_acquire) < target && !stopping.load()) {
+            wakeCv.notify_one();
+            std::this_thread::yield();
+        }
+    }
+
+    /**
+     * @brief Скільки повідомлень відкинуто через переповнення (ще не повідомлених у лог).
+     */
+    size_t getDroppedCount() const { return dropped.load(std::memory_order_relaxed); }
+
+private:
+    static void onCrashSignal(int sig) {
+        std::signal(sig, SIG_DFL);
+        // crashFd скидається в деструкторі, тож після нього знищений логер не чіпаємо
+        if (crashFd.load() >= 0) getInstance().writeCrashDump(sig);
+        std::raise(sig);
     }
 };
-// Макроси для зручного виклику
-#define LOG_INFO(msg) Logger::getInstance().log(LogLevel::Info, msg)
-#define LOG_WARN(msg) Logger::getInstance().log(LogLevel::Warning, msg)
-#define LOG_ERR(msg)  Logger::getInstance().log(LogLevel::Error, msg)
-#define LOG_DEBUG(msg) Logger::getInstance().log(LogLevel::Debug, msg)
\ No newline at end of file
+// Макроси для зручного виклику.
+// Аргумент обчислюється лише тоді, коли рівень пройшов обидва фільтри:
+// вимкнений під час компіляції рівень не генерує коду, вимкнений під час виконання — одне розгалуження.
+#define LOG_AT(level, msg) \
+    do { \
+        if constexpr (logSeverity(level) >= LOG_MIN_LEVEL) { \
+            if (Logger::isEnabled(level)) Logger::getInstance().log(level, msg); \
+        } \
+    } while (0)
+
+#define LOG_INFO(msg) LOG_AT(LogLevel::Info, msg)
+#define LOG_WARN(msg) LOG_AT(LogLevel::Warning, msg)
+#define LOG_ERR(msg)  LOG_AT(LogLevel::Error, msg)
+#define LOG_DEBUG(msg) LOG_AT(LogLevel::Debug, msg)
+
+// Структурована подія: key — ключ L10N з L10nKeys.h, перевіряється під час компіляції
+// (невідомий ключ не компілюється) і інтернується один раз на місце виклику.
+// Аргументи — цілі числа або LogStr{id} (наприклад, Entity::getNameId()).
+#define LOG_EVENT(level, key, ...) \
+    do { \
+        if constexpr (logSeverity(level) >= LOG_MIN_LEVEL) { \
+            if (Logger::isEnabled(level)) { \
+                constexpr L10nId logEventKey = l10nKey(key); \
+                static const uint32_t logEventKeyId = \
+                        Logger::intern(std::string(L10nKeys::names[logEventKey.index])); \
+                Logger::getInstance().event(level, logEventKeyId, {__VA_ARGS__}); \
+            } \
+        } \
+    } while (0)
@@ -3,10 +3,16 @@
 #include <vector>
 #include <cstdlib>
 #include <sstream>
+#include <thread>
+#include <algorithm>
+#include <optional>
 #include "Entity.h"
 #include "Zombie.h"
 #include "Player.h"
 #include "Logger.h"
+#include "TileGrid.h"
+#include "TileRandom.h"
+#include "ChunkedWorld.h"
 
 using namespace std;
 
@@ -14,58 +20,182 @@ using namespace std;
 #define UNTITLED23_MAP_H
 #endif
 
-const int TILE_FLOOR = 0; ///< Пуста підлога
-const int TILE_WALL = 1;  ///< Стіна
-const int TILE_POTION = 2;  ///< Зілля здоров'я
-const int TILE_AMMO = 3;    ///< Коробка з патронами
 /**
  * @brief Клас ігрової карти.
  * Відповідає за генерацію лабіринту та розміщення предметів.
+ * @details Невелика карта генерується цілком. Велика (див. generate) живе в ChunkedWorld,
+ * а getGrid() показує лише вікно WINDOW_SIZE x WINDOW_SIZE навколо гравця; координати
+ * в getGrid() — локальні, світові = локальні + getOriginX()/getOriginY().
  */
 class Map {
-    int width, height;
-    vector<vector<int>> grid;
+    static constexpr size_t PARALLEL_MIN_TILES = 256 * 256; ///< Поріг для багатопотокової генерації
+
+public:
+    static constexpr int WINDOW_SIZE = 128;  ///< Сторона вікна великої карти
+    static constexpr int WINDOW_MARGIN = 32; ///< Ближче до краю вікна — вікно зсувається
+    static constexpr int MAX_SIZE = 1 << 20; ///< Найбільша сторона карти
+
+private:
+    int width = 0, height = 0; ///< Розмір усього світу
+    uint64_t seed = 0; ///< Зерно, з якого згенеровано карту
+    TileGrid grid; ///< Суцільний буфер тайлів, 1 байт на клітинку (для великої карти — вікно)
+    int originX = 0, originY = 0; ///< Світові координати лівого верхнього кута вікна
+    optional<ChunkedWorld> world; ///< Чанки великої карти (порожньо для звичайної)
+
+    Map() = default;
+
+    /**
+     * @brief Заповнює рядки [y0, y1). Рядки різних потоків не перетинаються.
+     */
+    void generateRows(int y0, int y1, int wallPercent) {
+        for (int y = y0; y < y1; y++) {
+            for (int x = 0; x < width; x++) {
+                if (y == 0 || y == height - 1 || x == 0 || x == width - 1) {
+                    grid.set(x, y, TILE_WALL);
+                } else {
+                    grid.set(x, y, rollTile(TileRandom::percent(seed, x, y), wallPercent));
+                }
+            }
+        }
+    }
 public:
     /**
-     * @brief Конструктор, що генерує карту.
+     * @brief Конструктор, що генерує карту з випадковим зерном.
+     * @details Зерно береться з rand(), тож поведінка з srand() зберігається.
      * @param w Ширина.
      * @param h Висота.
      * @param wallPercent Відсоток стін.
      */
-    Map(int w, int h, int wallPercent) : width(w), height(h) {
-        grid = vector<vector<int>>(h, vector<int>(w, TILE_FLOOR));
+    Map(int w, int h, int wallPercent) : Map(w, h, wallPercent, (uint64_t)rand()) {}
 
-        for (int y = 0; y < h; y++) {
-            for (int x = 0; x < w; x++) {
-                if (y == 0 || y == h - 1 || x == 0 || x == w - 1) {
-                    grid[y][x] = TILE_WALL;
-                } else {
-                    int r = rand() % 100;
-                    if (r < wallPercent) {
-                        grid[y][x] = TILE_WALL;
-                    }
-                    else if (r < wallPercent + 3) {
-                        grid[y][x] = TILE_POTION;
-                    }
-                    else if (r < wallPercent + 3 + 3) {
-                        grid[y][x] = TILE_AMMO;
-                    }
-                }
+    /**
+     * @brief Конструктор, що детерміновано генерує карту із заданого зерна.
+     * @details Кожен тайл — чиста функція TileRandom::percent(seed, x, y), тому рядки
+     * розподіляються між потоками, а результат побітово однаковий для будь-якої
+     * кількості потоків.
+     * @param w Ширина.
+     * @param h Висота.
+     * @param wallPercent Відсоток стін.
+     * @param seed Зерно генерації.
+     * @param threads Кількість потоків (0 — за кількістю ядер).
+     */
+    Map(int w, int h, int wallPercent, uint64_t seed, unsigned threads = 0)
+            : width(w), height(h), seed(seed), grid(w, h, TILE_FLOOR) {
+        if (threads == 0) {
+            // Малі карти швидше згенерувати одним потоком, ніж запускати нові
+            threads = ((size_t)w * h < PARALLEL_MIN_TILES) ? 1 : max(1u, thread::hardware_concurrency());
+        }
+        threads = min<unsigned>(threads, (unsigned)max(h, 1));
+
+        if (threads <= 1) {
+            generateRows(0, h, wallPercent);
+        } else {
+            vector<thread> workers;
+            workers.reserve(threads);
+            for (unsigned t = 0; t < threads; ++t) {
+                int y0 = (int)((int64_t)h * t / threads);
+                int y1 = (int)((int64_t)h * (t + 1) / threads);
+                workers.emplace_back(&Map::generateRows, this, y0, y1, wallPercent);
             }
+            for (auto& worker : workers) worker.join();
         }
-        LOG_INFO("Map generated with Potions and Ammo.");
+        LOG_INFO("Map generated with Potions and Ammo. Seed: " + to_string(seed));
+    }
+
+    /**
+     * @brief Карта під розмір: до WINDOW_SIZE генерується цілком, більша — чанками.
+     * @details Велика карта стартує з вікном у лівому верхньому куті світу (там, де
+     * з'являється гравець). Тайли збігаються з Map(w, h, wallPercent, seed).
+     */
+    static Map generate(int w, int h, int wallPercent, uint64_t seed) {
+        if (w <= WINDOW_SIZE && h <= WINDOW_SIZE) return Map(w, h, wallPercent, seed);
+
+        Map map;
+        map.width = w;
+        map.height = h;
+        map.seed = seed;
+        map.world.emplace(w, h, wallPercent, seed);
+        map.grid = TileGrid(min(w, WINDOW_SIZE), min(h, WINDOW_SIZE), TILE_FLOOR);
+        map.world->copyWindow(0, 0, map.grid);
+        LOG_INFO("Chunked map " + to_string(w) + "x" + to_string(h) + " started. Seed: " + to_string(seed));
+        return map;
     }
+
+    uint64_t getSeed() const { return seed; }
+
     /**
      * @brief Очищує клітинку (перетворює на підлогу).
      * Використовується, коли гравець підбирає предмет.
+     * @param x Локальна координата X (у вікні).
+     * @param y Локальна координата Y (у вікні).
      */
     void clearTile(int x, int y) {
-        if (x >= 0 && x < width && y >= 0 && y < height) {
-            grid[y][x] = TILE_FLOOR;
+        if (grid.inBounds(x, y)) {
+            grid.set(x, y, TILE_FLOOR);
+            if (world) world->setTile(originX + x, originY + y, TILE_FLOOR);
         }
     }
 
-    const vector<vector<int>>& getGrid() const { return grid; }
+    /**
+     * @brief Тайл у світових координатах (зокрема поза вікном). Поза світом — стіна.
+     */
+    uint8_t tileAt(int worldX, int worldY) const {
+        if (world) return world->tileAt(worldX, worldY);
+        return grid.inBounds(worldX, worldY) ? grid.at(worldX, worldY) : TILE_WALL;
+    }
+
+    /**
+     * @brief Зсуває вікно великої карти, якщо гравець підійшов до його краю.
+     * @details Вікно центрується на гравці (у межах світу) і заповнюється з чанків,
+     * а чанки далі ніж за один від вікна вивантажуються.
+     * @param x Локальна координата X гравця.
+     * @param y Локальна координата Y гравця.
+     * @param shiftX На скільки клітинок зсунулося вікно по X (нова локальна X = x - shiftX).
+     * @param shiftY На скільки клітинок зсунулося вікно по Y.
+     * @return true, якщо вікно зсунулося.
+     */
+    bool recenter(int x, int y, int& shiftX, int& shiftY) {
+        shiftX = 0;
+        shiftY = 0;
+        if (!world) return false;
+
+        const int w = grid.getWidth();
+        const int h = grid.getHeight();
+        if (x >= WINDOW_MARGIN && x < w - WINDOW_MARGIN && y >= WINDOW_MARGIN && y < h - WINDOW_MARGIN) return false;
+
+        shiftX = clamp(originX + x - w / 2, 0, width - w) - originX;
+        shiftY = clamp(originY + y - h / 2, 0, height - h) - originY;
+        if (shiftX == 0 && shiftY == 0) return false;
+
+        originX += shiftX;
+        originY += shiftY;
+        world->copyWindow(originX, originY, grid);
+        const int keep = ChunkedWorld::CHUNK_SIZE;
+        world->evictOutside(originX - keep, originY - keep, originX + w + keep, originY + h + keep);
+        LOG_DEBUG("Map window moved to (" + to_string(originX) + "," + to_string(originY) + ")");
+        return true;
+    }
+
+    /**
+     * @brief Перегляд на тайли карти (без копіювання).
+     * @details Перегляд дійсний, поки карту не перегенеровано.
+     */
+    TileView getGrid() const { return grid.view(); }
+
+    int getWidth() const { return width; }
+    int getHeight() const { return height; }
+    int getOriginX() const { return originX; }
+    int getOriginY() const { return originY; }
+
+    /**
+     * @brief Чи живе карта в чанках (тоді getGrid() — лише вікно).
+     */
+    bool isChunked() const { return world.has_value(); }
+
+    /**
+     * @brief Сховище чанків великої карти або nullptr.
+     */
+    const ChunkedWorld* getWorld() const { return world ? &*world : nullptr; }
 
     void render(const Player& p, const vector<Entity*>& enemies) {
 
@@ -0,0 +1,83 @@
+#pragma once
+#include <vector>
+#include <cstdint>
+
+using namespace std;
+
+#ifndef UNTITLED23_OCCUPANCYGRID_H
+#define UNTITLED23_OCCUPANCYGRID_H
+#endif
+/**
+ * @brief Шар зайнятості клітинок, що зберігається поруч із картою.
+ * @details Для кожної клітинки зберігається id сутності, яка на ній стоїть (або EMPTY).
+ * У грі id — це номер слота EnemyHandle, тож він не змінюється при видаленні інших ворогів.
+ * Питання "чи зайнята клітинка" — це одне звернення до масиву, замість перебору
+ * всіх ворогів. Шар оновлюється при спавні, кожному кроці та видаленні ворога.
+ */
+class OccupancyGrid {
+public:
+    static constexpr int32_t EMPTY = -1; ///< Клітинка вільна
+
+private:
+    int width = 0, height = 0;
+    vector<int32_t> cells;
+
+    size_t index(int x, int y) const { return (size_t)y * width + x; }
+
+public:
+    OccupancyGrid() = default;
+    OccupancyGrid(int w, int h) { reset(w, h); }
+
+    /**
+     * @brief Змінює розмір шару і звільняє всі клітинки.
+     */
+    void reset(int w, int h) {
+        width = w;
+        height = h;
+        cells.assign((size_t)w * h, EMPTY);
+    }
+
+    bool inBounds(int x, int y) const { return x >= 0 && x < width && y >= 0 && y < height; }
+
+    /**
+     * @brief Чи стоїть хтось на клітинці (клітинки поза картою вважаються зайнятими).
+     */
+    bool isOccupied(int x, int y) const {
+        return !inBounds(x, y) || cells[index(x, y)] != EMPTY;
+    }
+
+    /**
+     * @brief Id сутності на клітинці або EMPTY.
+     */
+    int32_t occupantAt(int x, int y) const {
+        return inBounds(x, y) ? cells[index(x, y)] : EMPTY;
+    }
+
+    /**
+     * @brief Ставить сутність на вільну клітинку.
+     * @return false, якщо клітинка зайнята або поза картою.
+     */
+    bool place(int32_t id, int x, int y) {
+        if (isOccupied(x, y)) return false;
+        cells[index(x, y)] = id;
+        return true;
+    }
+
+    /**
+     * @brief Переносить сутність з однієї клітинки на іншу.
+     * @return false, якщо цільова клітинка зайнята.
+     */
+    bool move(int fromX, int fromY, int toX, int toY) {
+        if (!inBounds(fromX, fromY) || isOccupied(toX, toY)) return false;
+        cells[index(toX, toY)] = cells[index(fromX, fromY)];
+        cells[index(fromX, fromY)] = EMPTY;
+        return true;
+    }
+
+    /**
+     * @brief Звільняє клітинку (наприклад, коли ворога вбито).
+     */
+    void remove(int x, int y) {
+        if (inBounds(x, y)) cells[index(x, y)] = EMPTY;
+    }
+};
@@ -6,8 +6,8 @@
 #include "Weapon.h"
 #include "Sword.h"
 #include "Gun.h"
-#include "LocalizationManager.h"
 #include "Logger.h"
+#include "TileGrid.h"
 
 using namespace std;
 
@@ -27,9 +27,11 @@ class Player : public Entity {
 
 public:
     Player(const std::string& n, int h, int d, int sx, int sy)
-            : Entity(n, h, d), weapon(nullptr), score(0), x(sx), y(sy), weaponChosen(false) {}
+            : Entity(n, h, d, EntityKind::Player), weapon(nullptr), score(0), x(sx), y(sy), weaponChosen(false) {}
 
     ~Player() {}
+
+    static bool isKind(EntityKind k) { return k == EntityKind::Player; }
     /**
      * @brief Скидає стан гравця до початкового для нової гри.
      * @param startX Початкова позиція X.
@@ -90,7 +92,7 @@ public:
         if (choice == 1) weapon = make_unique<Sword>();
         else weapon = make_unique<Gun>();
         weaponChosen = true;
-        LOG_INFO(L10N.getFormattedString("player_equipped", name, weapon->getName()));
+        LOG_EVENT(LogLevel::Info, "player_equipped", LogStr{getNameId()}, LogStr{weapon->getNameId()});
     }
     /**
      * @brief Перевіряє, чи може гравець атакувати.
@@ -102,21 +104,32 @@ public:
         return true;
     }
 
-    void attack(Entity& target) override {
-        if (!weapon) return;
+    /**
+     * @brief Виконує удар поточною зброєю без прив'язки до цілі.
+     * @details Витрачає патрон для стрілецької зброї. Використовується, коли ціль
+     * зберігається не як Entity (наприклад, ворог у EnemyStore).
+     * @return Завдана шкода або 0, якщо атакувати нічим.
+     */
+    int strike() {
+        if (!weapon) return 0;
 
         if (weapon->isRanged()) {
             if (ammo > 0) {
                 ammo--;
                 LOG_INFO("Shot fired! Ammo left: " + to_string(ammo));
             } else {
-                return;
+                return 0;
             }
         }
 
         int totalDamage = damage + weapon->getDamage();
-        LOG_INFO(L10N.getFormattedString("player_deals_damage", totalDamage, weapon->getName()));
-        target.takeDamage(totalDamage);
+        LOG_EVENT(LogLevel::Info, "player_deals_damage", totalDamage, LogStr{weapon->getNameId()});
+        return totalDamage;
+    }
+
+    void attack(Entity& target) override {
+        int totalDamage = strike();
+        if (totalDamage > 0) target.takeDamage(totalDamage);
     }
 
     char getSymbol() const override { return 'P'; }
@@ -125,19 +138,27 @@ public:
     int getX() const { return x; }
     int getY() const { return y; }
 
+    /**
+     * @brief Переставляє гравця без перевірок (коли зсувається вікно великої карти).
+     */
+    void setPosition(int newX, int newY) {
+        x = newX;
+        y = newY;
+    }
+
     int getWeaponRange() const {
         return weapon ? weapon->getRange() : 1;
     }
 
-    void move(int dx, int dy, const vector<vector<int>>& map) {
+    void move(int dx, int dy, TileView map) {
         int nx = x + dx;
         int ny = y + dy;
-        if (nx >= 0 && nx < (int)map[0].size() && ny >= 0 && ny < (int)map.size()) {
-            if (map[ny][nx] != 1) {
+        if (map.inBounds(nx, ny)) {
+            if (map.at(nx, ny) != TILE_WALL) {
                 x = nx;
                 y = ny;
             } else {
-                LOG_INFO(L10N.getString("cant_move_wall"));
+                LOG_EVENT(LogLevel::Info, "cant_move_wall");
             }
         }
     }
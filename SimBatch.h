@@ -0,0 +1,279 @@
+#pragma once
+#include <vector>
+#include <thread>
+#include <atomic>
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
+#include "Simulation.h"
+#include "TileRandom.h"
+
+using namespace std;
+
+#ifndef UNTITLED23_SIMBATCH_H
+#define UNTITLED23_SIMBATCH_H
+#endif
+
+/**
+ * @brief Пакетні прогони Simulation для балансу: скриптований гравець, пул потоків, статистика.
+ * @details Використовується утилітою tools/zombie_sim.cpp. Кожна гра залежить лише від
+ * (config, seed), тож результати не залежать від кількості потоків.
+ */
+namespace SimBatch {
+
+    /**
+     * @brief Підсумок однієї гри.
+     */
+    struct GameResult {
+        SimStatus status = SimStatus::Running; ///< Running — ліміт ходів або вороги недосяжні
+        int turns = 0;
+        int damageTaken = 0;
+        int score = 0;
+    };
+
+    /**
+     * @brief Одна гра в черзі пакета.
+     */
+    struct Job {
+        SimConfig config;
+        uint64_t seed = 0;
+    };
+
+    /**
+     * @brief Розподіл значення серед ігор.
+     */
+    struct Distribution {
+        double mean = 0;
+        int p10 = 0;
+        int p50 = 0;
+        int p90 = 0;
+        int max = 0;
+    };
+
+    /**
+     * @brief Статистика групи ігор з однаковими параметрами.
+     */
+    struct Summary {
+        size_t games = 0;
+        size_t wins = 0;
+        size_t defeats = 0;
+        size_t timeouts = 0;
+        Distribution turns;
+        Distribution damageTaken;
+        Distribution score;
+
+        /**
+         * @brief Частка перемог серед усіх ігор (нічиї за лімітом ходів рахуються як не перемоги).
+         */
+        double winRate() const { return games ? (double)wins / (double)games : 0.0; }
+
+        /**
+         * @brief Частка перемог серед завершених ігор (перемога чи поразка), без нічиїх.
+         */
+        double decidedWinRate() const {
+            size_t decided = wins + defeats;
+            return decided ? (double)wins / (double)decided : 0.0;
+        }
+    };
+
+    /**
+     * @brief Зерно гри номер index у прогоні з базовим зерном base.
+     */
+    inline uint64_t gameSeed(uint64_t base, uint64_t index) {
+        return TileRandom::mix64(base ^ TileRandom::mix64(index));
+    }
+
+    /**
+     * @brief Напрямок першого кроку гравця до найближчого (за шляхом) ворога.
+     * @details Пошук у ширину від гравця по всіх клітинках, крім стін. Поле потоку
+     * симуляції для цього не годиться: вороги ходять лише по підлозі, а гравець ступає
+     * й на предмети (і підбирає їх, відкриваючи прохід ворогам). Буфери — thread_local,
+     * тож хід не виділяє пам'яті. Якщо у вікні великої карти активних ворогів немає,
+     * гравець іде до досяжної клітинки, найближчої до найближчого сплячого ворога.
+     * @return 0 — праворуч, 1 — ліворуч, 2 — вниз, 3 — вгору; -1, якщо жоден ворог не досяжний.
+     */
+    inline int stepTowardsNearestEnemy(const Simulation& sim) {
+        static constexpr int DX[4] = {1, -1, 0, 0};
+        static constexpr int DY[4] = {0, 0, 1, -1};
+        thread_local vector<int8_t> firstStep; // -2 — не відвідано, -1 — клітинка гравця
+        thread_local vector<int> queue;
+
+        TileView grid = sim.getMap().getGrid();
+        const OccupancyGrid& occupancy = sim.getOccupancy();
+        const int width = grid.getWidth();
+        const int px = sim.getPlayer().getX();
+        const int py = sim.getPlayer().getY();
+
+        firstStep.assign((size_t)width * grid.getHeight(), -2);
+        queue.clear();
+        firstStep[(size_t)py * width + px] = -1;
+        queue.push_back(py * width + px);
+        for (size_t head = 0; head < queue.size(); ++head) {
+            int x = queue[head] % width;
+            int y = queue[head] / width;
+            int8_t step = firstStep[(size_t)queue[head]];
+            if (step >= 0 && occupancy.occupantAt(x, y) != OccupancyGrid::EMPTY) return step;
+            for (int d = 0; d < 4; ++d) {
+                int nx = x + DX[d], ny = y + DY[d];
+                if (!grid.inBounds(nx, ny) || grid.at(nx, ny) == TILE_WALL) continue;
+                int8_t& next = firstStep[(size_t)ny * width + nx];
+                if (next != -2) continue;
+                next = (int8_t)(step >= 0 ? step : d);
+                queue.push_back(ny * width + nx);
+            }
+        }
+
+        const vector<DormantEnemy>& dormant = sim.getDormantEnemies();
+        if (dormant.empty()) return -1;
+        const int ox = sim.getMap().getOriginX();
+        const int oy = sim.getMap().getOriginY();
+        auto distTo = [&](const DormantEnemy& d, int x, int y) { return abs(d.worldX - ox - x) + abs(d.worldY - oy - y); };
+        const DormantEnemy* target = &dormant[0];
+        for (const DormantEnemy& d : dormant) {
+            if (distTo(d, px, py) < distTo(*target, px, py)) target = &d;
+        }
+        int best = -1;
+        int bestDist = distTo(*target, px, py);
+        for (int cell : queue) {
+            int dist = distTo(*target, cell % width, cell / width);
+            if (dist < bestDist) {
+                bestDist = dist;
+                best = firstStep[(size_t)cell];
+            }
+        }
+        return best;
+    }
+
+    /**
+     * @brief Чи може гра ще закінчитися: хтось у радіусі атаки або досяжний пішки.
+     * @details Інакше гравця чи ворога замуровано, і гравець чекатиме до ліміту ходів.
+     */
+    inline bool canProgress(const Simulation& sim) {
+        const Player& player = sim.getPlayer();
+        const EnemyStore& enemies = sim.getEnemies();
+        const int range = player.getWeaponName() == "Gun" ? player.getWeaponRange() : 1;
+        span<const int> xs = enemies.getXs();
+        span<const int> ys = enemies.getYs();
+        for (size_t i = 0; i < enemies.size(); ++i) {
+            if (abs(xs[i] - player.getX()) + abs(ys[i] - player.getY()) <= range) return true;
+        }
+        return stepTowardsNearestEnemy(sim) >= 0;
+    }
+
+    /**
+     * @brief Хід скриптованого гравця.
+     * @details Стартова зброя з конфігурації; пістолет без патронів міняється на меч
+     * і назад, коли патрони знайдено. Якщо ворог у радіусі — атака,
+     * інакше крок до найближчого (за шляхом) ворога, див. stepTowardsNearestEnemy.
+     */
+    inline PlayerAction scriptedAction(const Simulation& sim) {
+        const Player& player = sim.getPlayer();
+        const EnemyStore& enemies = sim.getEnemies();
+        const int px = player.getX();
+        const int py = player.getY();
+
+        bool wantGun = sim.getConfig().weapon != 1 && player.getAmmo() > 0;
+        if ((player.getWeaponName() == "Gun") != wantGun) return PlayerAction::SwapWeapon;
+
+        span<const int> xs = enemies.getXs();
+        span<const int> ys = enemies.getYs();
+        const int range = player.getWeaponRange();
+        for (size_t i = 0; i < enemies.size(); ++i) {
+            if (abs(xs[i] - px) + abs(ys[i] - py) <= range) return PlayerAction::Attack;
+        }
+
+        switch (stepTowardsNearestEnemy(sim)) {
+            case 0: return PlayerAction::MoveRight;
+            case 1: return PlayerAction::MoveLeft;
+            case 2: return PlayerAction::MoveDown;
+            case 3: return PlayerAction::MoveUp;
+        }
+        return PlayerAction::Attack; // Ніхто не досяжний — чекаємо на місці
+    }
+
+    /**
+     * @brief Грає одну гру скриптованим гравцем до кінця або до ліміту ходів.
+     */
+    inline GameResult playGame(Simulation& sim, const Job& job, int maxTurns) {
+        sim.reset(job.config, job.seed);
+
+        GameResult result;
+        // Зміна зброї не витрачає хід, тож рахуємо ще й дії, щоб не зациклитися
+        for (int actions = 0; !sim.isOver() && sim.getTurn() < maxTurns && actions < maxTurns * 2; ++actions) {
+            if (!canProgress(sim)) break;
+            sim.act(scriptedAction(sim));
+            for (const SimEvent& e : sim.getEvents()) {
+                if (e.type == SimEvent::Type::EnemyHitsPlayer) result.damageTaken += e.value;
+            }
+        }
+
+        result.status = sim.getStatus();
+        result.turns = sim.getTurn();
+        result.score = sim.getPlayer().getScore();
+        return result;
+    }
+
+    /**
+     * @brief Грає всі ігри на threadCount потоках.
+     * @details Потоки забирають наступну гру з атомарного лічильника, тож довгі
+     * й короткі ігри розподіляються самі. Кожен потік перевикористовує свою Simulation.
+     * @return Результати в порядку jobs.
+     */
+    inline vector<GameResult> run(const vector<Job>& jobs, unsigned threadCount, int maxTurns) {
+        vector<GameResult> results(jobs.size());
+        atomic<size_t> next{0};
+
+        auto worker = [&] {
+            Simulation sim;
+            for (size_t i = next.fetch_add(1, memory_order_relaxed); i < jobs.size();
+                 i = next.fetch_add(1, memory_order_relaxed)) {
+                results[i] = playGame(sim, jobs[i], maxTurns);
+            }
+        };
+
+        threadCount = max(1u, min<unsigned>(threadCount, (unsigned)max<size_t>(jobs.size(), 1)));
+        vector<thread> pool;
+        pool.reserve(threadCount - 1);
+        for (unsigned t = 1; t < threadCount; ++t) pool.emplace_back(worker);
+        worker();
+        for (thread& t : pool) t.join();
+        return results;
+    }
+
+    inline Distribution distribution(vector<int> values) {
+        Distribution d;
+        if (values.empty()) return d;
+        sort(values.begin(), values.end());
+        long long sum = 0;
+        for (int v : values) sum += v;
+        auto at = [&](double q) { return values[(size_t)(q * (double)(values.size() - 1))]; };
+        d.mean = (double)sum / (double)values.size();
+        d.p10 = at(0.1);
+        d.p50 = at(0.5);
+        d.p90 = at(0.9);
+        d.max = values.back();
+        return d;
+    }
+
+    /**
+     * @brief Зводить результати ігор [first, last) у статистику.
+     */
+    inline Summary summarize(const vector<GameResult>& results, size_t first, size_t last) {
+        Summary s;
+        vector<int> turns, damage, score;
+        for (size_t i = first; i < last; ++i) {
+            const GameResult& r = results[i];
+            ++s.games;
+            if (r.status == SimStatus::Victory) ++s.wins;
+            else if (r.status == SimStatus::Defeat) ++s.defeats;
+            else ++s.timeouts;
+            turns.push_back(r.turns);
+            damage.push_back(r.damageTaken);
+            score.push_back(r.score);
+        }
+        s.turns = distribution(std::move(turns));
+        s.damageTaken = distribution(std::move(damage));
+        s.score = distribution(std::move(score));
+        return s;
+    }
+}
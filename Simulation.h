@@ -0,0 +1,442 @@
+#pragma once
+#include <vector>
+#include <string>
+#include <random>
+#include <cstdint>
+#include <cstdlib>
+#include "Player.h"
+#include "Map.h"
+#include "FlowField.h"
+#include "OccupancyGrid.h"
+#include "EnemyStore.h"
+#include "TileRandom.h"
+#include "Logger.h"
+
+using namespace std;
+
+#ifndef UNTITLED23_SIMULATION_H
+#define UNTITLED23_SIMULATION_H
+#endif
+
+/**
+ * @brief Параметри однієї гри.
+ */
+struct SimConfig {
+    int mapWidth = 15;
+    int mapHeight = 15;
+    int enemyCount = 3;   ///< Разом з босом
+    int wallPercent = 20;
+    int weapon = 1;       ///< Стартова зброя (1 — меч, інше — пістолет), як у Player::chooseWeapon
+};
+
+/**
+ * @brief Дія гравця за один хід.
+ */
+enum class PlayerAction : uint8_t {
+    MoveUp,
+    MoveDown,
+    MoveLeft,
+    MoveRight,
+    Attack,
+    SwapWeapon ///< Не витрачає хід
+};
+
+/**
+ * @brief Стан партії.
+ */
+enum class SimStatus : uint8_t {
+    Running,
+    Victory,
+    Defeat
+};
+
+/**
+ * @brief Що сталося за хід — для шару показу (звуки, журнал) або статистики.
+ */
+struct SimEvent {
+    enum class Type : uint8_t {
+        WeaponSwapped,   ///< name — нова зброя
+        PickedPotion,    ///< x, y — клітинка, value — лікування
+        PickedAmmo,      ///< x, y — клітинка, value — патрони
+        NoTarget,        ///< Нікого в радіусі атаки
+        NoAmmo,          ///< Ціль є, але стріляти нічим
+        PlayerStrikes,   ///< name — ворог, value — шкода
+        EnemyKilled,     ///< name — ворог
+        EnemyHitsPlayer, ///< name — ворог, value — шкода
+        PlayerDied,      ///< name — хто вбив (порожньо, якщо загинув у свій хід)
+        WindowMoved,     ///< x, y — на скільки зсунулося вікно великої карти (див. Map::recenter)
+        Victory
+    };
+
+    Type type;
+    string name;
+    int value = 0;
+    int x = 0, y = 0;
+};
+
+/**
+ * @brief Ворог великої карти, що лишився поза вікном.
+ * @details Він не ходить і не займає клітинку в OccupancyGrid, доки вікно знову його не накриє.
+ */
+struct DormantEnemy {
+    EnemyType type;
+    string name;
+    int health, damage, rage;
+    int worldX, worldY;
+};
+
+/**
+ * @brief Покрокова симуляція гри без графіки, звуку та вікна.
+ * @details Тримає карту, гравця, ворогів і розв'язує ходи: дія гравця, підбір предметів,
+ * хід ворогів, перемога чи поразка. Нічого не знає про SFML, тож працює в тестах,
+ * ботах і серверах тисячі ходів на секунду. Game обгортає її для показу: після кожної
+ * дії читає getEvents() і перетворює події на звуки, рядки журналу та зміни на екрані.
+ *
+ * Велика карта (див. Map::generate) живе у вікні навколо гравця: гравець, вороги, поле
+ * потоку й шар зайнятості працюють у координатах вікна, а вороги поза ним сплять у dormant.
+ */
+class Simulation {
+    Player player;
+    EnemyStore enemies; ///< Вороги у форматі SoA
+    vector<DormantEnemy> dormant; ///< Вороги поза вікном великої карти
+    EnemyHandle currentTarget; ///< Ворог, якого гравець атакував останнім
+    Map map;
+    FlowField flowField; ///< Спільне поле руху ворогів, рахується раз за хід
+    OccupancyGrid occupancy; ///< Які клітинки зайняті ворогами
+    std::mt19937 spawnRng; ///< Окремий генератор для розміщення ворогів
+    SimConfig config;
+    uint64_t seed = 0;
+    SimStatus status = SimStatus::Running;
+    int turn = 0;
+    vector<SimEvent> events;
+
+    void emit(SimEvent::Type type, string name = {}, int value = 0, int x = 0, int y = 0) {
+        events.push_back({type, std::move(name), value, x, y});
+    }
+
+    /**
+     * @brief Чи стоїть ворог на клітинці світу (у вікні чи серед сплячих).
+     */
+    bool isTaken(int worldX, int worldY) const {
+        int x = worldX - map.getOriginX();
+        int y = worldY - map.getOriginY();
+        if (occupancy.inBounds(x, y)) return occupancy.isOccupied(x, y);
+        for (const DormantEnemy& d : dormant) {
+            if (d.worldX == worldX && d.worldY == worldY) return true;
+        }
+        return false;
+    }
+
+    /**
+     * @brief Додає ворога у світових координатах: у вікні він активний, поза ним — спить.
+     */
+    void addEnemy(EnemyType type, const string& name, int hp, int dmg, int rage, int worldX, int worldY) {
+        int x = worldX - map.getOriginX();
+        int y = worldY - map.getOriginY();
+        if (occupancy.inBounds(x, y)) {
+            EnemyHandle enemy = enemies.add(type, name, hp, dmg, rage, x, y);
+            occupancy.place((int32_t)enemy.index, x, y);
+        } else {
+            dormant.push_back({type, name, hp, dmg, rage, worldX, worldY});
+        }
+    }
+
+    void spawnEnemies() {
+        const int originX = map.getOriginX();
+        const int originY = map.getOriginY();
+        const int playerX = originX + player.getX();
+        const int playerY = originY + player.getY();
+
+        // Спавн Боса у дальньому куті
+        if (config.enemyCount > 0) {
+            int bossX = config.mapWidth - 2;
+            int bossY = config.mapHeight - 2;
+            if (map.tileAt(bossX, bossY) == TILE_WALL) { bossX--; }
+
+            addEnemy(EnemyType::Boss, "BOSS", 120, 20, 7, bossX, bossY);
+            LOG_INFO("Boss spawned at (" + to_string(bossX) + "," + to_string(bossY) + ")");
+        }
+
+        // Випадковий спавн зомбі на вільних клітинах
+        for (int i = 0; i < config.enemyCount - 1; ++i) {
+            int z_x = 0, z_y = 0;
+            bool validSpot = false;
+            int attempts = 0;
+
+            // Шукаємо вільне місце (до 50 спроб)
+            while (!validSpot && attempts < 50) {
+                z_x = std::uniform_int_distribution<int>(1, config.mapWidth - 2)(spawnRng);
+                z_y = std::uniform_int_distribution<int>(1, config.mapHeight - 2)(spawnRng);
+
+                int distToPlayer = abs(z_x - playerX) + abs(z_y - playerY);
+                // Перевірка: не стіна і не занадто близько до гравця
+                if (map.tileAt(z_x, z_y) != TILE_WALL && distToPlayer > 3 && !isTaken(z_x, z_y)) {
+                    validSpot = true;
+                }
+                attempts++;
+            }
+
+            // Запасний варіант: перша вільна клітинка вікна з дальнього кута
+            TileView grid = map.getGrid();
+            for (int y = grid.getHeight() - 2; y > 0 && !validSpot; --y) {
+                for (int x = grid.getWidth() - 2; x > 0 && !validSpot; --x) {
+                    if (grid.at(x, y) != TILE_WALL && !occupancy.isOccupied(x, y) &&
+                        (x != player.getX() || y != player.getY())) {
+                        z_x = originX + x;
+                        z_y = originY + y;
+                        validSpot = true;
+                    }
+                }
+            }
+            if (!validSpot) {
+                LOG_WARN("No free cell left for zombie spawn.");
+                break;
+            }
+
+            addEnemy(EnemyType::Zombie, "Zombie " + std::to_string(i + 1), 50, 10, 0, z_x, z_y);
+        }
+
+        LOG_INFO("Total enemies active: " + to_string(enemies.size()) + ", dormant: " + to_string(dormant.size()));
+    }
+
+    /**
+     * @brief Зсуває вікно великої карти за гравцем.
+     * @details Гравець і активні вороги переходять у нові локальні координати; ті, хто
+     * опинився поза вікном, засинають, а сплячі, яких вікно накрило, прокидаються
+     * на вільній клітинці. Шар зайнятості й поле потоку будуються заново.
+     */
+    void followPlayer() {
+        int shiftX = 0, shiftY = 0;
+        if (!map.recenter(player.getX(), player.getY(), shiftX, shiftY)) return;
+
+        player.setPosition(player.getX() - shiftX, player.getY() - shiftY);
+        enemies.translate(-shiftX, -shiftY);
+
+        const int originX = map.getOriginX();
+        const int originY = map.getOriginY();
+        for (size_t i = enemies.size(); i-- > 0;) {
+            if (occupancy.inBounds(enemies.getX(i), enemies.getY(i))) continue;
+            dormant.push_back({enemies.getType(i), enemies.getName(i), enemies.getHealth(i), enemies.getDamage(i),
+                               enemies.getRage(i), originX + enemies.getX(i), originY + enemies.getY(i)});
+            enemies.remove(i);
+        }
+
+        TileView grid = map.getGrid();
+        occupancy.reset(grid.getWidth(), grid.getHeight());
+        for (size_t i = 0; i < enemies.size(); ++i) {
+            occupancy.place((int32_t)enemies.handleAt(i).index, enemies.getX(i), enemies.getY(i));
+        }
+
+        for (size_t i = 0; i < dormant.size();) {
+            const DormantEnemy& d = dormant[i];
+            int x = d.worldX - originX;
+            int y = d.worldY - originY;
+            if (!grid.inBounds(x, y) || grid.at(x, y) == TILE_WALL || occupancy.isOccupied(x, y) ||
+                (x == player.getX() && y == player.getY())) {
+                ++i;
+                continue;
+            }
+            EnemyHandle enemy = enemies.add(d.type, d.name, d.health, d.damage, d.rage, x, y);
+            occupancy.place((int32_t)enemy.index, x, y);
+            dormant[i] = std::move(dormant.back());
+            dormant.pop_back();
+        }
+
+        flowField.compute(player.getX(), player.getY(), grid);
+        emit(SimEvent::Type::WindowMoved, {}, 0, shiftX, shiftY);
+    }
+
+    void playerAttack() {
+        int weaponRange = player.getWeaponRange();
+
+        span<const int> xs = enemies.getXs();
+        span<const int> ys = enemies.getYs();
+        const int px = player.getX();
+        const int py = player.getY();
+        auto inRange = [&](size_t i) { return abs(xs[i] - px) + abs(ys[i] - py) <= weaponRange; };
+
+        // Спершу б'ємо ту саму ціль, що й минулого разу (дескриптор переживає видалення інших)
+        size_t target = enemies.find(currentTarget);
+        if (target != EnemyStore::npos && !inRange(target)) {
+            target = EnemyStore::npos;
+        }
+        for (size_t i = 0; i < enemies.size() && target == EnemyStore::npos; ++i) {
+            if (inRange(i)) target = i;
+        }
+
+        if (target == EnemyStore::npos) {
+            // Без патронів до пістолета мовчимо, як і раніше
+            if (!(player.getAmmo() <= 0 && player.getWeaponRange() > 1)) emit(SimEvent::Type::NoTarget);
+            return;
+        }
+
+        if (!player.canAttack()) {
+            emit(SimEvent::Type::NoAmmo);
+            return;
+        }
+
+        LOG_DEBUG("Player engaged enemy: " + enemies.getName(target));
+
+        currentTarget = enemies.handleAt(target);
+        int damage = player.strike();
+        enemies.takeDamage(target, damage);
+        emit(SimEvent::Type::PlayerStrikes, enemies.getName(target), damage);
+
+        if (!player.isAlive()) {
+            LOG_INFO("Player died during attack phase.");
+            status = SimStatus::Defeat;
+            emit(SimEvent::Type::PlayerDied);
+            return;
+        }
+
+        if (!enemies.isAlive(target)) {
+            LOG_INFO("Enemy neutralized: " + enemies.getName(target));
+            emit(SimEvent::Type::EnemyKilled, enemies.getName(target));
+            player.addScore(50);
+            occupancy.remove(xs[target], ys[target]);
+            enemies.remove(target);
+        }
+    }
+
+    void pickUpItems() {
+        int px = player.getX();
+        int py = player.getY();
+        int tileType = map.getGrid().at(px, py);
+
+        if (tileType == TILE_POTION) { //Зілля
+            LOG_INFO("Picked up Health Potion");
+            player.heal(25);
+            map.clearTile(px, py);
+            flowField.updateTile(px, py, map.getGrid());
+            emit(SimEvent::Type::PickedPotion, {}, 25, px, py);
+        }
+        else if (tileType == TILE_AMMO) { // Патрони
+            LOG_INFO("Picked up Ammo Pack");
+            player.addAmmo(5);
+            map.clearTile(px, py);
+            flowField.updateTile(px, py, map.getGrid());
+            emit(SimEvent::Type::PickedAmmo, {}, 5, px, py);
+        }
+    }
+
+    void enemyTurn() {
+        flowField.retarget(player.getX(), player.getY(), map.getGrid());
+
+        span<const int> xs = enemies.getXs();
+        span<const int> ys = enemies.getYs();
+        const int px = player.getX();
+        const int py = player.getY();
+
+        for (size_t i = 0; i < enemies.size(); ++i) {
+            int dx = abs(xs[i] - px);
+            int dy = abs(ys[i] - py);
+
+            if (dx + dy == 1) {
+                int damage = enemies.getAttackDamage(i);
+                enemies.attack(i, player);
+                emit(SimEvent::Type::EnemyHitsPlayer, enemies.getName(i), damage);
+
+                if (!player.isAlive()) {
+                    LOG_INFO("DEFEAT. Player killed by " + enemies.getName(i));
+                    status = SimStatus::Defeat;
+                    emit(SimEvent::Type::PlayerDied, enemies.getName(i));
+                    break;
+                }
+            }
+            else {
+                enemies.moveTowards(i, flowField, occupancy);
+            }
+        }
+    }
+
+public:
+    Simulation() : player("Player", 100, 20, 1, 1), map(15, 15, 20) {}
+
+    /**
+     * @brief Починає нову гру: карта з зерна, гравець у (1, 1), бос і зомбі.
+     * @details Та сама пара (config, seed) завжди дає ту саму гру.
+     */
+    void reset(const SimConfig& cfg, uint64_t worldSeed) {
+        config = cfg;
+        seed = worldSeed;
+        spawnRng.seed(static_cast<uint32_t>(TileRandom::mix64(seed)));
+        LOG_INFO("World seed: " + to_string(seed));
+
+        map = Map::generate(config.mapWidth, config.mapHeight, config.wallPercent, seed);
+
+        player.reset(1, 1);
+        player.chooseWeapon(config.weapon);
+        enemies.clear();
+        dormant.clear();
+        occupancy.reset(map.getGrid().getWidth(), map.getGrid().getHeight());
+        flowField.compute(player.getX(), player.getY(), map.getGrid());
+        currentTarget = EnemyHandle{};
+
+        spawnEnemies();
+
+        status = SimStatus::Running;
+        turn = 0;
+        events.clear();
+    }
+
+    /**
+     * @brief Виконує дію гравця і, якщо хід витрачено, хід ворогів.
+     * @details Рух у стіну теж витрачає хід. Події ходу доступні через getEvents()
+     * до наступного виклику act().
+     * @return false, якщо гра вже закінчилася.
+     */
+    bool act(PlayerAction action) {
+        events.clear();
+        if (status != SimStatus::Running) return false;
+
+        bool turnTaken = true;
+        switch (action) {
+            case PlayerAction::MoveUp:    player.move(0, -1, map.getGrid()); break;
+            case PlayerAction::MoveDown:  player.move(0, 1, map.getGrid()); break;
+            case PlayerAction::MoveLeft:  player.move(-1, 0, map.getGrid()); break;
+            case PlayerAction::MoveRight: player.move(1, 0, map.getGrid()); break;
+            case PlayerAction::Attack:    playerAttack(); break;
+            case PlayerAction::SwapWeapon:
+                player.swapWeapon();
+                emit(SimEvent::Type::WeaponSwapped, player.getWeaponName());
+                turnTaken = false;
+                break;
+        }
+        if (status != SimStatus::Running) return true;
+
+        followPlayer();
+
+        //Перевірка умови перемоги
+        if (enemies.size() == 0 && dormant.empty()) {
+            LOG_INFO("VICTORY! All enemies defeated.");
+            status = SimStatus::Victory;
+            emit(SimEvent::Type::Victory);
+            return true;
+        }
+
+        pickUpItems();
+
+        if (turnTaken && player.isAlive()) {
+            enemyTurn();
+            ++turn;
+        }
+        return true;
+    }
+
+    const vector<SimEvent>& getEvents() const { return events; }
+    SimStatus getStatus() const { return status; }
+    bool isOver() const { return status != SimStatus::Running; }
+    int getTurn() const { return turn; }
+    uint64_t getSeed() const { return seed; }
+    const SimConfig& getConfig() const { return config; }
+
+    Player& getPlayer() { return player; }
+    const Player& getPlayer() const { return player; }
+    Map& getMap() { return map; }
+    const Map& getMap() const { return map; }
+    EnemyStore& getEnemies() { return enemies; }
+    const EnemyStore& getEnemies() const { return enemies; }
+    const vector<DormantEnemy>& getDormantEnemies() const { return dormant; }
+    const OccupancyGrid& getOccupancy() const { return occupancy; }
+    const FlowField& getFlowField() const { return flowField; }
+};
@@ -0,0 +1,169 @@
+#pragma once
+#include <vector>
+#include <cstdint>
+#include <utility>
+
+using namespace std;
+
+#ifndef UNTITLED23_SLOTMAP_H
+#define UNTITLED23_SLOTMAP_H
+#endif
+
+/**
+ * @brief Стабільний дескриптор елемента у SlotMap / SlotIndex.
+ * @details Складається з номера слота та покоління. Коли елемент видаляють, покоління
+ * слота збільшується, тож старий дескриптор більше нічого не знаходить, навіть якщо
+ * слот уже зайняв інший елемент. Дескриптор можна тримати між ходами (ціль, снаряд, UI).
+ */
+struct SlotHandle {
+    uint32_t index = UINT32_MAX;
+    uint32_t generation = 0;
+
+    bool isNull() const { return index == UINT32_MAX; }
+    bool operator==(const SlotHandle& other) const = default;
+};
+
+/**
+ * @brief Відображення дескрипторів на щільні позиції (без самих даних).
+ * @details Дані зберігаються щільно, без дірок (у одному векторі або в кількох
+ * паралельних стовпцях), а SlotIndex лише пам'ятає, де зараз лежить кожен елемент.
+ * Видалення — swap-and-pop: останній елемент переїжджає на місце видаленого за O(1).
+ */
+class SlotIndex {
+    vector<uint32_t> slotToDense; ///< Позиція елемента для кожного слота
+    vector<uint32_t> generations; ///< Поточне покоління кожного слота
+    vector<uint32_t> denseToSlot; ///< Слот для кожної щільної позиції
+    vector<uint32_t> freeSlots;   ///< Вільні слоти для повторного використання
+
+public:
+    /**
+     * @brief Реєструє новий елемент, доданий у кінець щільного масиву.
+     */
+    SlotHandle insert() {
+        uint32_t slot;
+        if (!freeSlots.empty()) {
+            slot = freeSlots.back();
+            freeSlots.pop_back();
+        } else {
+            slot = (uint32_t)slotToDense.size();
+            slotToDense.push_back(0);
+            generations.push_back(0);
+        }
+        slotToDense[slot] = (uint32_t)denseToSlot.size();
+        denseToSlot.push_back(slot);
+        return {slot, generations[slot]};
+    }
+
+    /**
+     * @brief Чи вказує дескриптор на живий елемент.
+     */
+    bool contains(SlotHandle h) const {
+        return h.index < generations.size() && generations[h.index] == h.generation &&
+               slotToDense[h.index] < denseToSlot.size() && denseToSlot[slotToDense[h.index]] == h.index;
+    }
+
+    /**
+     * @brief Щільна позиція елемента (дескриптор має бути дійсним).
+     */
+    uint32_t denseOf(SlotHandle h) const { return slotToDense[h.index]; }
+
+    /**
+     * @brief Дескриптор елемента на щільній позиції.
+     */
+    SlotHandle handleAt(size_t dense) const {
+        uint32_t slot = denseToSlot[dense];
+        return {slot, generations[slot]};
+    }
+
+    /**
+     * @brief Поточний дескриптор слота (перевіряйте contains — слот може бути вільним).
+     * @details Для шарів, що зберігають лише номер слота (наприклад, OccupancyGrid).
+     */
+    SlotHandle handleOfSlot(uint32_t slot) const {
+        return {slot, slot < generations.size() ? generations[slot] : 0};
+    }
+
+    /**
+     * @brief Видаляє елемент на щільній позиції.
+     * @details Викликач має сам перенести дані з позиції size()-1 у dense
+     * (та сама операція swap-and-pop для кожного стовпця).
+     */
+    void eraseDense(size_t dense) {
+        uint32_t slot = denseToSlot[dense];
+        uint32_t lastSlot = denseToSlot.back();
+        denseToSlot[dense] = lastSlot;
+        slotToDense[lastSlot] = (uint32_t)dense;
+        denseToSlot.pop_back();
+
+        ++generations[slot];
+        freeSlots.push_back(slot);
+    }
+
+    size_t size() const { return denseToSlot.size(); }
+
+    void clear() {
+        // Покоління зберігаються, щоб старі дескриптори не ожили після очищення
+        for (uint32_t slot : denseToSlot) {
+            ++generations[slot];
+            freeSlots.push_back(slot);
+        }
+        denseToSlot.clear();
+    }
+};
+
+/**
+ * @brief Slot map: щільний вектор значень + стабільні дескриптори з поколіннями.
+ * @tparam T Тип значень.
+ */
+template<typename T>
+class SlotMap {
+    vector<T> values;
+    SlotIndex slots;
+
+public:
+    SlotHandle insert(T value) {
+        values.push_back(std::move(value));
+        return slots.insert();
+    }
+
+    bool contains(SlotHandle h) const { return slots.contains(h); }
+
+    /**
+     * @brief Вказівник на значення або nullptr, якщо дескриптор застарів.
+     */
+    T* get(SlotHandle h) { return contains(h) ? &values[slots.denseOf(h)] : nullptr; }
+    const T* get(SlotHandle h) const { return contains(h) ? &values[slots.denseOf(h)] : nullptr; }
+
+    /**
+     * @brief Видаляє елемент за щільною позицією за O(1) (swap-and-pop).
+     */
+    void eraseAt(size_t dense) {
+        if (dense >= values.size()) return;
+        if (dense != values.size() - 1) values[dense] = std::move(values.back());
+        values.pop_back();
+        slots.eraseDense(dense);
+    }
+
+    bool erase(SlotHandle h) {
+        if (!contains(h)) return false;
+        eraseAt(slots.denseOf(h));
+        return true;
+    }
+
+    SlotHandle handleAt(size_t dense) const { return slots.handleAt(dense); }
+
+    T& operator[](size_t dense) { return values[dense]; }
+    const T& operator[](size_t dense) const { return values[dense]; }
+
+    size_t size() const { return values.size(); }
+
+    void clear() {
+        values.clear();
+        slots.clear();
+    }
+
+    auto begin() { return values.begin(); }
+    auto end() { return values.end(); }
+    auto begin() const { return values.begin(); }
+    auto end() const { return values.end(); }
+};
@@ -0,0 +1,50 @@
+#pragma once
+#include <SFML/Graphics.hpp>
+
+using namespace std;
+
+#ifndef UNTITLED23_SPRITEBATCH_H
+#define UNTITLED23_SPRITEBATCH_H
+#endif
+/**
+ * @brief Збирає спрайти з однієї текстури (атласа) в один масив вершин.
+ * @details Кожен кадр: begin(), add() для кожного спрайта, window.draw(batch) —
+ * один виклик draw незалежно від кількості спрайтів. Масив вершин між кадрами
+ * не звільняється, тож після першого кадру пам'ять не виділяється.
+ */
+class SpriteBatch : public sf::Drawable {
+    sf::VertexArray vertices{sf::Quads};
+    const sf::Texture* texture = nullptr;
+
+public:
+    /**
+     * @brief Починає новий кадр.
+     * @param atlas Текстура, з якої беруться всі регіони.
+     */
+    void begin(const sf::Texture& atlas) {
+        texture = &atlas;
+        vertices.clear();
+    }
+
+    /**
+     * @brief Додає спрайт: регіон атласа, розтягнутий на прямокутник у світі.
+     */
+    void add(const sf::IntRect& region, sf::Vector2f position, sf::Vector2f size, sf::Color color = sf::Color::White) {
+        float left = (float)region.left;
+        float top = (float)region.top;
+        float right = left + region.width;
+        float bottom = top + region.height;
+        vertices.append(sf::Vertex(position, color, {left, top}));
+        vertices.append(sf::Vertex({position.x + size.x, position.y}, color, {right, top}));
+        vertices.append(sf::Vertex(position + size, color, {right, bottom}));
+        vertices.append(sf::Vertex({position.x, position.y + size.y}, color, {left, bottom}));
+    }
+
+    size_t getSpriteCount() const { return vertices.getVertexCount() / 4; }
+
+private:
+    void draw(sf::RenderTarget& target, sf::RenderStates states) const override {
+        states.texture = texture;
+        target.draw(vertices, states);
+    }
+};
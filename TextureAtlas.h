@@ -0,0 +1,127 @@
+#pragma once
+#include <SFML/Graphics.hpp>
+#include <string>
+#include <vector>
+#include <unordered_map>
+#include <algorithm>
+#include <numeric>
+#include "Logger.h"
+
+using namespace std;
+
+#ifndef UNTITLED23_TEXTUREATLAS_H
+#define UNTITLED23_TEXTUREATLAS_H
+#endif
+/**
+ * @brief Атлас: усі спрайти гри, упаковані в одну текстуру під час завантаження.
+ * @details Зображення додаються за іменем (loadImage/addImage), а build() розкладає їх
+ * полицями (спершу найвищі) і заливає одну sf::Texture. Завдяки цьому карта та всі
+ * сутності малюються з однією текстурою, без перемикань між спрайтами.
+ * Атлас завжди містить білий регіон WHITE — через нього одноколірна геометрія
+ * (зілля, коробки) малюється тією самою текстурою.
+ */
+class TextureAtlas {
+public:
+    static constexpr unsigned PADDING = 1;       ///< Проміжок між спрайтами, щоб сусіди не просвічували
+    static constexpr unsigned MAX_WIDTH = 2048;  ///< Ширина, після якої починається нова полиця
+    static inline const string WHITE = "white";  ///< Суцільний білий регіон
+
+private:
+    vector<pair<string, sf::Image>> pending;
+    unordered_map<string, sf::IntRect> regions;
+    sf::Texture texture;
+
+public:
+    /**
+     * @brief Розкладає прямокутники полицями.
+     * @param sizes Розміри спрайтів.
+     * @param maxWidth Максимальна ширина атласа.
+     * @param total [out] Розмір атласа, що вміщує всі спрайти.
+     * @return Лівий верхній кут кожного спрайта (у порядку sizes).
+     */
+    static vector<sf::Vector2u> pack(const vector<sf::Vector2u>& sizes, unsigned maxWidth, sf::Vector2u& total) {
+        vector<size_t> order(sizes.size());
+        iota(order.begin(), order.end(), 0);
+        stable_sort(order.begin(), order.end(), [&](size_t a, size_t b) { return sizes[a].y > sizes[b].y; });
+
+        vector<sf::Vector2u> positions(sizes.size());
+        unsigned x = 0, y = 0, shelfHeight = 0;
+        total = {0, 0};
+        for (size_t i : order) {
+            if (x > 0 && x + sizes[i].x > maxWidth) { // Полиця заповнена — переходимо на нову
+                y += shelfHeight + PADDING;
+                x = 0;
+                shelfHeight = 0;
+            }
+            positions[i] = {x, y};
+            x += sizes[i].x + PADDING;
+            shelfHeight = max(shelfHeight, sizes[i].y);
+            total.x = max(total.x, positions[i].x + sizes[i].x);
+            total.y = max(total.y, y + sizes[i].y);
+        }
+        return positions;
+    }
+
+    /**
+     * @brief Завантажує зображення (поточна тека, потім assets/) і ставить у чергу на пакування.
+     * @return false, якщо файл не знайдено.
+     */
+    bool loadImage(const string& name, const string& filename) {
+        sf::Image image;
+        if (!image.loadFromFile(filename) && !image.loadFromFile("assets/" + filename)) {
+            LOG_ERR("Error loading " + filename);
+            return false;
+        }
+        addImage(name, image);
+        return true;
+    }
+
+    void addImage(const string& name, const sf::Image& image) {
+        pending.emplace_back(name, image);
+    }
+
+    /**
+     * @brief Пакує всі додані зображення в одну текстуру.
+     * @return false, якщо текстуру не вдалося створити.
+     */
+    bool build(unsigned maxWidth = MAX_WIDTH) {
+        sf::Image white;
+        white.create(2, 2, sf::Color::White);
+        pending.emplace_back(WHITE, white);
+
+        vector<sf::Vector2u> sizes;
+        sizes.reserve(pending.size());
+        for (const auto& [name, image] : pending) sizes.push_back(image.getSize());
+
+        sf::Vector2u total;
+        vector<sf::Vector2u> positions = pack(sizes, maxWidth, total);
+
+        sf::Image sheet;
+        sheet.create(max(total.x, 1u), max(total.y, 1u), sf::Color::Transparent);
+        regions.clear();
+        for (size_t i = 0; i < pending.size(); ++i) {
+            sheet.copy(pending[i].second, positions[i].x, positions[i].y);
+            regions[pending[i].first] = sf::IntRect((int)positions[i].x, (int)positions[i].y,
+                                                    (int)sizes[i].x, (int)sizes[i].y);
+        }
+        pending.clear();
+
+        if (!texture.loadFromImage(sheet)) {
+            LOG_ERR("Could not create texture atlas");
+            return false;
+        }
+        LOG_INFO("Texture atlas built: " + to_string(total.x) + "x" + to_string(total.y) +
+                 ", " + to_string(regions.size()) + " sprites");
+        return true;
+    }
+
+    /**
+     * @brief Регіон спрайта в атласі (порожній, якщо такого немає).
+     */
+    sf::IntRect get(const string& name) const {
+        auto it = regions.find(name);
+        return it == regions.end() ? sf::IntRect() : it->second;
+    }
+
+    const sf::Texture& getTexture() const { return texture; }
+};
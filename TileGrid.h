@@ -0,0 +1,115 @@
+#pragma once
+#include <vector>
+#include <span>
+#include <cstdint>
+#include <cstddef>
+#include <initializer_list>
+
+using namespace std;
+
+#ifndef UNTITLED23_TILEGRID_H
+#define UNTITLED23_TILEGRID_H
+#endif
+
+const uint8_t TILE_FLOOR = 0; ///< Пуста підлога
+const uint8_t TILE_WALL = 1;  ///< Стіна
+const uint8_t TILE_POTION = 2;  ///< Зілля здоров'я
+const uint8_t TILE_AMMO = 3;    ///< Коробка з патронами
+
+/**
+ * @brief Перетворює випадкове число 0..99 на тип тайла (спільно для Map і ChunkedWorld).
+ * @param r Кидок кубика (0..99).
+ * @param wallPercent Відсоток стін.
+ */
+inline uint8_t rollTile(int r, int wallPercent) {
+    if (r < wallPercent) return TILE_WALL;
+    if (r < wallPercent + 3) return TILE_POTION;
+    if (r < wallPercent + 3 + 3) return TILE_AMMO;
+    return TILE_FLOOR;
+}
+
+class TileGrid;
+
+/**
+ * @brief Невласний перегляд (view) на плаский масив тайлів.
+ * @details Тайли лежать одним суцільним блоком рядок за рядком, по 1 байту на клітинку.
+ * Доступ до (x, y) — це одне множення на stride і одне додавання, без подвійної
+ * індексації vector<vector<int>>. Перегляд дешево копіюється за значенням.
+ */
+class TileView {
+    const uint8_t* data = nullptr;
+    int width = 0, height = 0;
+    size_t stride = 0; ///< Відстань між початками сусідніх рядків (у байтах)
+
+public:
+    TileView() = default;
+    TileView(const uint8_t* d, int w, int h, size_t s) : data(d), width(w), height(h), stride(s) {}
+    TileView(const TileGrid& grid);
+
+    int getWidth() const { return width; }
+    int getHeight() const { return height; }
+    size_t getStride() const { return stride; }
+
+    bool inBounds(int x, int y) const { return x >= 0 && x < width && y >= 0 && y < height; }
+
+    /**
+     * @brief Тип тайла у клітинці без перевірки меж.
+     */
+    uint8_t at(int x, int y) const { return data[y * stride + x]; }
+
+    /**
+     * @brief Рядок карти як суцільний span (для лінійних проходів).
+     */
+    span<const uint8_t> row(int y) const { return {data + y * stride, (size_t)width}; }
+
+    span<const uint8_t> operator[](int y) const { return row(y); }
+};
+
+/**
+ * @brief Власник плаского буфера тайлів (по 1 байту на клітинку).
+ */
+class TileGrid {
+    int width = 0, height = 0;
+    vector<uint8_t> tiles;
+
+public:
+    TileGrid() = default;
+
+    /**
+     * @brief Створює сітку, заповнену одним типом тайла.
+     * @param w Ширина.
+     * @param h Висота.
+     * @param fill Тайл за замовчуванням.
+     */
+    TileGrid(int w, int h, uint8_t fill = TILE_FLOOR) : width(w), height(h), tiles((size_t)w * h, fill) {}
+
+    /**
+     * @brief Створює сітку з вкладеного списку рядків (зручно для тестів).
+     */
+    TileGrid(initializer_list<initializer_list<int>> rows) {
+        height = (int)rows.size();
+        width = height > 0 ? (int)rows.begin()->size() : 0;
+        tiles.reserve((size_t)width * height);
+        for (const auto& r : rows) {
+            for (int t : r) tiles.push_back((uint8_t)t);
+        }
+    }
+
+    int getWidth() const { return width; }
+    int getHeight() const { return height; }
+
+    bool inBounds(int x, int y) const { return x >= 0 && x < width && y >= 0 && y < height; }
+
+    uint8_t at(int x, int y) const { return tiles[(size_t)y * width + x]; }
+    void set(int x, int y, uint8_t tile) { tiles[(size_t)y * width + x] = tile; }
+
+    span<uint8_t> operator[](int y) { return {tiles.data() + (size_t)y * width, (size_t)width}; }
+    span<const uint8_t> operator[](int y) const { return {tiles.data() + (size_t)y * width, (size_t)width}; }
+
+    const uint8_t* data() const { return tiles.data(); }
+
+    TileView view() const { return TileView(tiles.data(), width, height, (size_t)width); }
+};
+
+inline TileView::TileView(const TileGrid& grid)
+        : data(grid.data()), width(grid.getWidth()), height(grid.getHeight()), stride((size_t)grid.getWidth()) {}
@@ -0,0 +1,247 @@
+#pragma once
+#include <SFML/Graphics.hpp>
+#include <vector>
+#include <cmath>
+#include <cstdint>
+#include <algorithm>
+#include "TileGrid.h"
+
+using namespace std;
+
+#ifndef UNTITLED23_TILELAYER_H
+#define UNTITLED23_TILELAYER_H
+#endif
+/**
+ * @brief Статичний шар карти (підлога, стіни, предмети), запечений у масиви вершин.
+ * @details Будується після генерації карти чи зсуву вікна великої карти (build) і малюється однією
+ * текстурою атласа — до чотирьох викликів draw на чанк.
+ * Предмети беруть колір з білого регіону атласа, тож перемикань текстур немає.
+ * Кожна клітинка знає, де лежать її вершини в кожному шарі, тож зміна тайла
+ * (updateTile після Map::clearTile) переписує лише ці вершини, а не весь шар.
+ * Звільнені місця перевикористовуються, тож шар не росте від підбирання предметів.
+ *
+ * Карта поділена на чанки CHUNK_TILES x CHUNK_TILES зі своїми масивами вершин.
+ * drawVisible() малює лише чанки, що перетинають видимий прямокутник, тож вартість
+ * кадру залежить від розміру екрана, а не карти.
+ */
+class TileLayer : public sf::Drawable {
+public:
+    static constexpr float TILE_SIZE = 32.f; ///< Розмір клітинки у пікселях світу
+    static constexpr int CHUNK_TILES = 16;   ///< Сторона чанка у клітинках
+
+    /**
+     * @brief Прямокутник клітинок, які видно через view (обрізаний межами карти).
+     * @details Поворот view не враховується — гра його не використовує.
+     */
+    static sf::IntRect visibleTiles(const sf::View& view, int mapWidth, int mapHeight) {
+        sf::Vector2f half = view.getSize() / 2.f;
+        sf::Vector2f center = view.getCenter();
+        int left = max(0, (int)floor((center.x - half.x) / TILE_SIZE));
+        int top = max(0, (int)floor((center.y - half.y) / TILE_SIZE));
+        int right = min(mapWidth, (int)ceil((center.x + half.x) / TILE_SIZE));
+        int bottom = min(mapHeight, (int)ceil((center.y + half.y) / TILE_SIZE));
+        return {left, top, max(0, right - left), max(0, bottom - top)};
+    }
+
+private:
+    enum LayerId { FLOOR, WALLS, POTIONS, AMMO, LAYER_COUNT };
+
+    static constexpr size_t POTION_SEGMENTS = 16; ///< Трикутників у колі зілля
+
+    /**
+     * @brief Один масив вершин і відповідність клітинка -> вершини.
+     */
+    struct Layer {
+        sf::VertexArray vertices;
+        size_t verticesPerTile = 4;
+        vector<int32_t> slotOf;    ///< Клітинка чанка -> перша вершина або -1
+        vector<int32_t> freeSlots; ///< Сховані місця, які можна зайняти знову
+    };
+
+    /**
+     * @brief Шари одного чанка.
+     */
+    struct Chunk {
+        Layer layers[LAYER_COUNT];
+    };
+
+    vector<Chunk> chunks;
+    int chunksX = 0, chunksY = 0;
+    const sf::Texture* texture = nullptr;
+    sf::FloatRect floorRegion;
+    sf::FloatRect wallRegion;
+    sf::Vector2f whiteTexel; ///< Середина білого регіону — для одноколірних предметів
+    int width = 0, height = 0;
+
+    static bool matches(int layer, uint8_t tile) {
+        switch (layer) {
+            case FLOOR:   return tile != TILE_WALL;
+            case WALLS:   return tile == TILE_WALL;
+            case POTIONS: return tile == TILE_POTION;
+            case AMMO:    return tile == TILE_AMMO;
+        }
+        return false;
+    }
+
+    static void quad(sf::Vertex* v, float x, float y, float w, float h, sf::Color color, const sf::FloatRect& tex) {
+        v[0] = sf::Vertex({x, y}, color, {tex.left, tex.top});
+        v[1] = sf::Vertex({x + w, y}, color, {tex.left + tex.width, tex.top});
+        v[2] = sf::Vertex({x + w, y + h}, color, {tex.left + tex.width, tex.top + tex.height});
+        v[3] = sf::Vertex({x, y + h}, color, {tex.left, tex.top + tex.height});
+    }
+
+    /**
+     * @brief Записує вершини клітинки (x, y) у шар, як їх малював старий покадровий рендер.
+     */
+    void emit(int layer, int x, int y, sf::Vertex* v) const {
+        float px = x * TILE_SIZE;
+        float py = y * TILE_SIZE;
+        switch (layer) {
+            case FLOOR:
+                quad(v, px, py, TILE_SIZE, TILE_SIZE, sf::Color::White, floorRegion);
+                break;
+            case WALLS:
+                quad(v, px, py, TILE_SIZE, TILE_SIZE, sf::Color::White, wallRegion);
+                break;
+            case POTIONS: {
+                // Коло радіуса 10 з відступом 6, як sf::CircleShape(10) раніше
+                const float radius = 10.f;
+                sf::Vector2f center(px + 6.f + radius, py + 6.f + radius);
+                for (size_t i = 0; i < POTION_SEGMENTS; ++i) {
+                    float a0 = 2.f * 3.14159265f * i / POTION_SEGMENTS;
+                    float a1 = 2.f * 3.14159265f * (i + 1) / POTION_SEGMENTS;
+                    v[i * 3] = sf::Vertex(center, sf::Color::Green, whiteTexel);
+                    v[i * 3 + 1] = sf::Vertex(center + radius * sf::Vector2f(cos(a0), sin(a0)), sf::Color::Green, whiteTexel);
+                    v[i * 3 + 2] = sf::Vertex(center + radius * sf::Vector2f(cos(a1), sin(a1)), sf::Color::Green, whiteTexel);
+                }
+                break;
+            }
+            case AMMO: {
+                // Чорна рамка товщиною 1 під жовтою коробкою 14x14
+                sf::FloatRect white(whiteTexel, {0.f, 0.f});
+                quad(v, px + 8.f, py + 8.f, 16.f, 16.f, sf::Color::Black, white);
+                quad(v + 4, px + 9.f, py + 9.f, 14.f, 14.f, sf::Color::Yellow, white);
+                break;
+            }
+        }
+    }
+
+    /**
+     * @brief Приводить вершини клітинки в шарі до її поточного тайла.
+     */
+    void place(int layer, int x, int y, uint8_t tile) {
+        Layer& l = chunks[(size_t)(y / CHUNK_TILES) * chunksX + x / CHUNK_TILES].layers[layer];
+        size_t cell = (size_t)(y % CHUNK_TILES) * CHUNK_TILES + x % CHUNK_TILES;
+        int32_t slot = l.slotOf[cell];
+        bool wanted = matches(layer, tile);
+
+        if (slot >= 0 && !wanted) {
+            // Вироджуємо вершини в точку — нічого не малюється, місце йде у вільні
+            for (size_t i = 0; i < l.verticesPerTile; ++i) l.vertices[slot + i] = sf::Vertex();
+            l.freeSlots.push_back(slot);
+            l.slotOf[cell] = -1;
+        } else if (slot < 0 && wanted) {
+            if (!l.freeSlots.empty()) {
+                slot = l.freeSlots.back();
+                l.freeSlots.pop_back();
+            } else {
+                slot = (int32_t)l.vertices.getVertexCount();
+                l.vertices.resize(slot + l.verticesPerTile);
+            }
+            l.slotOf[cell] = slot;
+            emit(layer, x, y, &l.vertices[slot]);
+        }
+    }
+
+public:
+    TileLayer() = default;
+
+    /**
+     * @brief Запікає всю карту заново (після генерації нової карти).
+     * @param atlas Текстура атласа (має жити, доки живе шар).
+     * @param floor Регіон підлоги в атласі.
+     * @param wall Регіон стін.
+     * @param white Суцільний білий регіон (TextureAtlas::WHITE).
+     */
+    void build(TileView tiles, const sf::Texture& atlas, const sf::IntRect& floor, const sf::IntRect& wall,
+               const sf::IntRect& white) {
+        texture = &atlas;
+        floorRegion = sf::FloatRect(floor);
+        wallRegion = sf::FloatRect(wall);
+        whiteTexel = {white.left + white.width / 2.f, white.top + white.height / 2.f};
+        width = tiles.getWidth();
+        height = tiles.getHeight();
+        chunksX = (width + CHUNK_TILES - 1) / CHUNK_TILES;
+        chunksY = (height + CHUNK_TILES - 1) / CHUNK_TILES;
+        chunks.assign((size_t)chunksX * chunksY, Chunk());
+        for (Chunk& chunk : chunks) {
+            for (Layer& l : chunk.layers) l.slotOf.assign((size_t)CHUNK_TILES * CHUNK_TILES, -1);
+            chunk.layers[FLOOR].vertices.setPrimitiveType(sf::Quads);
+            chunk.layers[WALLS].vertices.setPrimitiveType(sf::Quads);
+            chunk.layers[POTIONS].vertices.setPrimitiveType(sf::Triangles);
+            chunk.layers[POTIONS].verticesPerTile = POTION_SEGMENTS * 3;
+            chunk.layers[AMMO].vertices.setPrimitiveType(sf::Quads);
+            chunk.layers[AMMO].verticesPerTile = 8;
+        }
+        for (int y = 0; y < height; ++y) {
+            span<const uint8_t> row = tiles.row(y);
+            for (int x = 0; x < width; ++x) {
+                for (int layer = 0; layer < LAYER_COUNT; ++layer) place(layer, x, y, row[x]);
+            }
+        }
+    }
+
+    /**
+     * @brief Оновлює вершини однієї клітинки після зміни тайла (наприклад, Map::clearTile).
+     */
+    void updateTile(int x, int y, TileView tiles) {
+        if (x < 0 || x >= width || y < 0 || y >= height || !tiles.inBounds(x, y)) return;
+        uint8_t tile = tiles.at(x, y);
+        for (int layer = 0; layer < LAYER_COUNT; ++layer) place(layer, x, y, tile);
+    }
+
+    /**
+     * @brief Скільки вершин у шарах (для діагностики).
+     */
+    size_t getVertexCount() const {
+        size_t total = 0;
+        for (const Chunk& chunk : chunks) {
+            for (const Layer& l : chunk.layers) total += l.vertices.getVertexCount();
+        }
+        return total;
+    }
+
+    /**
+     * @brief Малює лише чанки, що перетинають прямокутник клітинок (див. visibleTiles).
+     * @return Скільки чанків намальовано.
+     */
+    size_t drawVisible(sf::RenderTarget& target, const sf::IntRect& tilesRect,
+                       sf::RenderStates states = sf::RenderStates::Default) const {
+        if (tilesRect.width <= 0 || tilesRect.height <= 0 || chunks.empty()) return 0;
+        int cx0 = max(0, tilesRect.left / CHUNK_TILES);
+        int cy0 = max(0, tilesRect.top / CHUNK_TILES);
+        int cx1 = min(chunksX - 1, (tilesRect.left + tilesRect.width - 1) / CHUNK_TILES);
+        int cy1 = min(chunksY - 1, (tilesRect.top + tilesRect.height - 1) / CHUNK_TILES);
+
+        states.texture = texture;
+        size_t drawn = 0;
+        for (int cy = cy0; cy <= cy1; ++cy) {
+            for (int cx = cx0; cx <= cx1; ++cx) {
+                drawChunk(target, chunks[(size_t)cy * chunksX + cx], states);
+                ++drawn;
+            }
+        }
+        return drawn;
+    }
+
+private:
+    static void drawChunk(sf::RenderTarget& target, const Chunk& chunk, const sf::RenderStates& states) {
+        for (const Layer& l : chunk.layers) {
+            if (l.vertices.getVertexCount() > 0) target.draw(l.vertices, states);
+        }
+    }
+
+    void draw(sf::RenderTarget& target, sf::RenderStates states) const override {
+        drawVisible(target, {0, 0, width, height}, states);
+    }
+};
@@ -0,0 +1,38 @@
+#pragma once
+#include <cstdint>
+
+#ifndef UNTITLED23_TILERANDOM_H
+#define UNTITLED23_TILERANDOM_H
+#endif
+/**
+ * @brief Лічильниковий (counter-based) генератор випадкових чисел для тайлів.
+ * @details Замість спільного стану (як у rand()) кожне число — це чиста функція
+ * від (seed, x, y). Тому будь-який рядок чи чанк можна згенерувати незалежно,
+ * у будь-якому порядку і в будь-якому потоці, а результат для одного seed завжди однаковий.
+ */
+namespace TileRandom {
+
+    /**
+     * @brief Фіналізатор SplitMix64: добре перемішує біти 64-бітного числа.
+     */
+    inline uint64_t mix64(uint64_t v) {
+        v += 0x9E3779B97F4A7C15ull;
+        v = (v ^ (v >> 30)) * 0xBF58476D1CE4E5B9ull;
+        v = (v ^ (v >> 27)) * 0x94D049BB133111EBull;
+        return v ^ (v >> 31);
+    }
+
+    /**
+     * @brief Випадкове 64-бітне число для клітинки (x, y) світу із зерном seed.
+     */
+    inline uint64_t at(uint64_t seed, int64_t x, int64_t y) {
+        return mix64(seed ^ mix64((uint64_t)x ^ mix64((uint64_t)y)));
+    }
+
+    /**
+     * @brief Кидок 0..99 для клітинки (аналог rand() % 100).
+     */
+    inline int percent(uint64_t seed, int64_t x, int64_t y) {
+        return (int)(at(seed, x, y) % 100);
+    }
+}
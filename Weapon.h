@@ -1,5 +1,6 @@
 #pragma once
 #include <iostream>
+#include "Logger.h"
 using namespace std;
 
 #ifndef UNTITLED23_WEAPON_H
@@ -13,6 +14,7 @@ protected:
     string name;
     int damage;
     int range;
+    mutable uint32_t nameId = Logger::NOT_INTERNED; ///< Інтернується при першій події з цією зброєю
 
 public:
     Weapon(string n, int d, int r = 1) : name(n), damage(d), range(r) {}
@@ -23,6 +25,11 @@ public:
     virtual string getName() const { return name; }
     virtual int getRange() const { return range; }
 
+    /**
+     * @brief Id назви зброї для аргументу LOG_EVENT (див. Logger::internCached).
+     */
+    uint32_t getNameId() const { return Logger::internCached(nameId, name); }
+
     /**
      * @brief Чи вимагає зброя патронів?
      * @return true для вогнепальної зброї.
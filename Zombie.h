@@ -2,9 +2,9 @@
 #include <iostream>
 #include <vector>
 #include <cmath>
-#include "LocalizationManager.h"
 #include "Entity.h"
 #include "Logger.h"
+#include "TileGrid.h"
 
 using namespace std;
 
@@ -17,19 +17,26 @@ using namespace std;
 class Zombie : public Entity {
     int x, y;
 
+protected:
+    /**
+     * @brief Конструктор для нащадків, що задають власний вид (Boss).
+     */
+    Zombie(const string& n, int h, int d, int sx, int sy, EntityKind k)
+            : Entity(n, h, d, k), x(sx), y(sy) {}
+
 public:
-    Zombie() : Entity("Zombie", 50, 10), x(0), y(0) {}
+    Zombie() : Entity("Zombie", 50, 10, EntityKind::Zombie), x(0), y(0) {}
 
     Zombie(const string& n, int h, int d, int sx, int sy)
-            : Entity(n, h, d), x(sx), y(sy) {}
-
-    void attack(Entity& target) override {
-        LOG_INFO(L10N.getString("zombie_attack_header"));
-        LOG_INFO(L10N.getFormattedString("zombie_bites_target", name, health, target.getName(), target.getHealth()));
+            : Entity(n, h, d, EntityKind::Zombie), x(sx), y(sy) {}
 
-        target.takeDamage(damage);
+    /**
+     * @brief Чи є сутність цього виду зомбі (бос — теж зомбі).
+     */
+    static bool isKind(EntityKind k) { return k == EntityKind::Zombie || k == EntityKind::Boss; }
 
-        LOG_INFO(L10N.getFormattedString("target_hp_remaining", target.getName(), target.getHealth()));
+    void attack(Entity& target) override {
+        enemyAttack(kind, nameId, name, health, damage, 0, target);
     }
 
     /**
@@ -39,9 +46,11 @@ public:
      * @param targetX Координата X цілі.
      * @param targetY Координата Y цілі.
      * @param mapGrid Карта.
-     * @param allEnemies Список усіх ворогів (для уникнення колізій).
+     * @param allEnemies Усі вороги (для уникнення колізій): vector<Entity*> або
+     * перегляд Container::all() / ofType<Zombie>() без копіювання.
      */
-    void moveTowards(int targetX, int targetY, const vector<vector<int>>& mapGrid, const vector<Entity*>& allEnemies) {
+    template<typename EnemyRange>
+    void moveTowards(int targetX, int targetY, TileView mapGrid, const EnemyRange& allEnemies) {
         int dx = targetX - x;
         int dy = targetY - y;
 
@@ -56,7 +65,7 @@ public:
             nextY += (dy > 0) ? 1 : -1;
         }
         // Перевірка на стіни (1 - це стіна)
-        if (nextX < 0 || nextX >= (int)mapGrid[0].size() || nextY < 0 || nextY >= (int)mapGrid.size() || mapGrid[nextY][nextX] != 0) {
+        if (!mapGrid.inBounds(nextX, nextY) || mapGrid.at(nextX, nextY) != TILE_FLOOR) {
             LOG_DEBUG(name + " hit a wall at (" + to_string(nextX) + "," + to_string(nextY) + "). Trying alternative path.");
 
             nextX = x;
@@ -68,7 +77,7 @@ public:
                 if (dx != 0) nextX += (dx > 0) ? 1 : -1;
             }
 
-            if (mapGrid[nextY][nextX] != 0) {
+            if (mapGrid.at(nextX, nextY) != TILE_FLOOR) {
                 LOG_DEBUG(name + " is stuck (alternative path blocked).");
                 return;
             }
@@ -76,7 +85,7 @@ public:
 
         // Перевірка на інших зомбі
         for (const auto* enemy : allEnemies) {
-            if (const auto* z = dynamic_cast<const Zombie*>(enemy)) {
+            if (const auto* z = entity_cast<Zombie>(enemy)) {
                 if (z == this) continue;
                 if (z->getX() == nextX && z->getY() == nextY) {
                     LOG_DEBUG(name + " blocked by another enemy at (" + to_string(nextX) + "," + to_string(nextY) + ")");
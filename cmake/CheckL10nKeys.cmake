@@ -0,0 +1,24 @@
+# Перевіряє, що кожен ключ з L10nKeys.h є в усіх файлах мов.
+# Використання: cmake -DKEYS_HEADER=<L10nKeys.h> -DLANG_FILES="<en.json>;<ukr.json>" -P CheckL10nKeys.cmake
+
+file(STRINGS "${KEYS_HEADER}" key_lines REGEX "^[ \t]*\"[A-Za-z0-9_]+\",[ \t]*$")
+if(NOT key_lines)
+    message(FATAL_ERROR "No localization keys found in ${KEYS_HEADER}")
+endif()
+
+set(missing "")
+foreach(lang_file IN LISTS LANG_FILES)
+    file(READ "${lang_file}" lang_json)
+    foreach(line IN LISTS key_lines)
+        string(REGEX REPLACE "^[ \t]*\"([A-Za-z0-9_]+)\",.*$" "\\1" key "${line}")
+        string(JSON value ERROR_VARIABLE lookup_error GET "${lang_json}" "${key}")
+        if(lookup_error)
+            list(APPEND missing "${lang_file}: ${key}")
+        endif()
+    endforeach()
+endforeach()
+
+if(missing)
+    list(JOIN missing "\n  " missing_text)
+    message(FATAL_ERROR "Localization keys missing from language files:\n  ${missing_text}")
+endif()
@@ -5,8 +5,23 @@
 #include "../Map.h"
 #include "../Container.h"
 #include "../Inventory.h" // Добавили хедер Инвентаря
+#include "../FlowField.h"
+#include "../TileGrid.h"
+#include "../ChunkedWorld.h"
+#include "../OccupancyGrid.h"
+#include "../EnemyStore.h"
+#include "../SlotMap.h"
+#include "../TileLayer.h"
+#include "../TextureAtlas.h"
+#include "../SpriteBatch.h"
+#include "../Simulation.h"
+#include "../SimBatch.h"
+#include "../LocalizationManager.h"
 #include <vector>
 #include <fstream> // Для тестов локализации
+#include <thread>
+#include <sstream>
+#include <filesystem>
 
 // --- СУЩЕСТВУЮЩИЕ ТЕСТЫ (COMBAT & BASIC MOVEMENT) ---
 
@@ -118,7 +133,7 @@ TEST(MovementLogic, PlayerMovesToEmptyCell) {
 // Тест 11: Перевірка, що player не може рухатись у стіну
 TEST(MovementLogic, PlayerCannotMoveIntoWall) {
     Player player("Hero", 100, 20, 1, 1);
-    vector<vector<int>> grid = {
+    TileGrid grid = {
         {1, 1, 1},
         {1, 0, 1},
         {1, 1, 1}
@@ -284,7 +299,7 @@ TEST(LocalizationManager, LoadMalformedJsonFile) {
 
 // Тест 24: Зомбі рухається до гравця по горизонталі
 TEST(ZombieAI, MovesTowardsPlayerHorizontally) {
-    vector<vector<int>> grid(5, vector<int>(5, 0));
+    TileGrid grid(5, 5, TILE_FLOOR);
     Zombie zombie("Walker", 50, 10, 1, 1);
     vector<Entity*> enemies;
 
@@ -297,7 +312,7 @@ TEST(ZombieAI, MovesTowardsPlayerHorizontally) {
 
 // Тест 25: Зомбі рухається до гравця по вертикалі
 TEST(ZombieAI, MovesTowardsPlayerVertically) {
-    vector<vector<int>> grid(5, vector<int>(5, 0));
+    TileGrid grid(5, 5, TILE_FLOOR);
     Zombie zombie("Walker", 50, 10, 1, 1);
     vector<Entity*> enemies;
 
@@ -310,7 +325,7 @@ TEST(ZombieAI, MovesTowardsPlayerVertically) {
 
 // Тест 26: Зомбі обходить стіну
 TEST(ZombieAI, ZombieAvoidsWall) {
-    vector<vector<int>> grid(5, vector<int>(5, 0));
+    TileGrid grid(5, 5, TILE_FLOOR);
     grid[1][2] = 1; // Стіна справа від зомбі (який на 1,1)
     Zombie zombie("Walker", 50, 10, 1, 1);
     vector<Entity*> enemies;
@@ -327,7 +342,7 @@ TEST(ZombieAI, ZombieAvoidsWall) {
 
 // Тест 27: Зомбі не накладаються один на одного
 TEST(ZombieAI, ZombieBlockedByAnotherZombie) {
-    vector<vector<int>> grid(5, vector<int>(5, 0));
+    TileGrid grid(5, 5, TILE_FLOOR);
     Zombie z1("Z1", 50, 10, 1, 1);
     Zombie z2("Z2", 50, 10, 2, 1); // Стоїть на шляху Z1 праворуч
     vector<Entity*> enemies = { &z1, &z2 };
@@ -420,4 +435,1072 @@ TEST(WeaponLogic, WeaponProperties) {
     Sword sword;
     ASSERT_FALSE(sword.isRanged());
     ASSERT_EQ(sword.getRange(), 1); // Melee range is usually 1 (or 0 depending on logic, assumed 1)
-}
\ No newline at end of file
+}
+
+// Тест 35: Поле потоку рахує відстань у кроках, обходячи стіни
+TEST(FlowFieldLogic, DistancesGoAroundWalls) {
+    TileGrid grid = {
+        {0, 1, 0},
+        {0, 1, 0},
+        {0, 0, 0}
+    };
+    FlowField field;
+    field.compute(0, 0, grid);
+
+    ASSERT_EQ(field.distanceAt(0, 0), 0);
+    ASSERT_EQ(field.distanceAt(2, 0), 6);
+    ASSERT_EQ(field.distanceAt(1, 0), FlowField::UNREACHABLE);
+}
+
+// Тест 36: Зомбі за стіною не застрягає, а йде в обхід по полю
+TEST(ZombieAI, ZombieFollowsFlowFieldAroundWall) {
+    TileGrid grid = {
+        {0, 1, 0},
+        {0, 1, 0},
+        {0, 0, 0}
+    };
+    FlowField field;
+    field.compute(0, 0, grid);
+    EnemyStore enemies;
+    enemies.add(EnemyType::Zombie, "Walker", 50, 10, 0, 2, 0);
+    OccupancyGrid occupancy(3, 3);
+    occupancy.place(0, 2, 0);
+
+    for (int step = 0; step < 5; ++step) {
+        enemies.moveTowards(0, field, occupancy);
+    }
+
+    ASSERT_EQ(enemies.getX(0), 0);
+    ASSERT_EQ(enemies.getY(0), 1);
+}
+
+// Тест 37: Зайнята клітинка на полі потоку пропускається
+TEST(ZombieAI, FlowFieldStepSkipsOccupiedCell) {
+    TileGrid grid(3, 3, TILE_FLOOR);
+    FlowField field;
+    field.compute(0, 0, grid);
+    EnemyStore enemies;
+    enemies.add(EnemyType::Zombie, "Z1", 50, 10, 0, 1, 1);
+    OccupancyGrid occupancy(3, 3);
+    occupancy.place(0, 1, 1);
+    occupancy.place(1, 0, 1); // Z2 стоїть ліворуч від Z1
+
+    enemies.moveTowards(0, field, occupancy);
+
+    ASSERT_EQ(enemies.getX(0), 1);
+    ASSERT_EQ(enemies.getY(0), 0);
+    ASSERT_EQ(occupancy.occupantAt(1, 0), 0);
+    ASSERT_FALSE(occupancy.isOccupied(1, 1));
+}
+
+// Тест 38: Інкрементальний ремонт поля збігається з повним перерахунком
+TEST(FlowFieldLogic, IncrementalRetargetMatchesFullRecompute) {
+    srand(42);
+    Map map(40, 30, 25);
+    const auto& grid = map.getGrid();
+
+    int px = 1, py = 1;
+    map.clearTile(px, py);
+    FlowField incremental;
+    incremental.compute(px, py, grid);
+
+    const int DX[4] = {1, -1, 0, 0};
+    const int DY[4] = {0, 0, 1, -1};
+    for (int step = 0; step < 200; ++step) {
+        int dir = rand() % 4;
+        int nx = px + DX[dir], ny = py + DY[dir];
+        if (grid[ny][nx] == 1) continue;
+        px = nx; py = ny;
+        incremental.retarget(px, py, grid);
+
+        FlowField full;
+        full.compute(px, py, grid);
+        for (int y = 0; y < 30; ++y)
+            for (int x = 0; x < 40; ++x)
+                ASSERT_EQ(incremental.distanceAt(x, y), full.distanceAt(x, y));
+    }
+}
+
+// Тест 39: Поява стіни перераховує лише залежну частину поля
+TEST(FlowFieldLogic, WallChangeRepairsField) {
+    TileGrid grid(6, 6, TILE_FLOOR);
+    FlowField field;
+    field.compute(0, 0, grid);
+
+    grid[0][1] = 1;
+    grid[1][1] = 1;
+    field.updateTile(1, 0, grid);
+    field.updateTile(1, 1, grid);
+    FlowField full;
+    full.compute(0, 0, grid);
+    for (int y = 0; y < 6; ++y)
+        for (int x = 0; x < 6; ++x)
+            ASSERT_EQ(field.distanceAt(x, y), full.distanceAt(x, y));
+
+    grid[1][1] = 0;
+    field.updateTile(1, 1, grid);
+    full.compute(0, 0, grid);
+    ASSERT_EQ(field.distanceAt(5, 0), full.distanceAt(5, 0));
+    ASSERT_EQ(field.distanceAt(2, 0), 4);
+}
+
+// Тест 40: Тайли карти лежать одним суцільним блоком по 1 байту
+TEST(MapLogic, TilesAreContiguousRowMajorBytes) {
+    Map map(7, 4, 0);
+    TileView view = map.getGrid();
+
+    ASSERT_EQ(view.getWidth(), 7);
+    ASSERT_EQ(view.getHeight(), 4);
+    ASSERT_EQ(view.getStride(), 7u);
+    ASSERT_EQ(view.row(1).data(), view.row(0).data() + view.getStride());
+    ASSERT_EQ(view.at(0, 0), TILE_WALL);
+    ASSERT_EQ(view.at(3, 2), TILE_FLOOR);
+    ASSERT_EQ(view[2][3], view.at(3, 2));
+}
+
+// Тест 41: Карта з одним зерном однакова для будь-якої кількості потоків
+TEST(MapLogic, SeededGenerationIsIndependentOfThreadCount) {
+    Map single(300, 250, 20, 12345, 1);
+    Map parallel(300, 250, 20, 12345, 7);
+    Map other(300, 250, 20, 54321, 1);
+
+    TileView a = single.getGrid();
+    TileView b = parallel.getGrid();
+    TileView c = other.getGrid();
+    bool differs = false;
+    for (int y = 0; y < 250; ++y) {
+        for (int x = 0; x < 300; ++x) {
+            ASSERT_EQ(a.at(x, y), b.at(x, y));
+            differs = differs || a.at(x, y) != c.at(x, y);
+        }
+    }
+    ASSERT_TRUE(differs);
+}
+
+// Тест 42: Шар зайнятості оновлюється при спавні, русі та видаленні
+TEST(OccupancyLogic, PlaceMoveRemove) {
+    OccupancyGrid occupancy(4, 4);
+    ASSERT_TRUE(occupancy.place(7, 1, 1));
+    ASSERT_FALSE(occupancy.place(8, 1, 1));
+    ASSERT_TRUE(occupancy.isOccupied(-1, 0));
+
+    ASSERT_TRUE(occupancy.move(1, 1, 2, 1));
+    ASSERT_EQ(occupancy.occupantAt(2, 1), 7);
+    ASSERT_FALSE(occupancy.isOccupied(1, 1));
+
+    occupancy.remove(2, 1);
+    ASSERT_FALSE(occupancy.isOccupied(2, 1));
+}
+
+// Тест 43: Бос у SoA-сховищі б'є з урахуванням люті, як клас Boss
+TEST(EnemyStoreLogic, BossAttackIncludesRage) {
+    EnemyStore enemies;
+    Player player("Hero", 100, 10, 1, 1);
+    EnemyHandle boss = enemies.add(EnemyType::Boss, "BigBoss", 200, 30, 15, 1, 2);
+    EnemyHandle zombie = enemies.add(EnemyType::Zombie, "Walker", 50, 10, 0, 2, 1);
+
+    enemies.attack(enemies.find(boss), player);
+    ASSERT_EQ(player.getHealth(), 100 - 45);
+
+    enemies.attack(enemies.find(zombie), player);
+    ASSERT_EQ(player.getHealth(), 55 - 10);
+}
+
+// Тест 44: Видалення ворога зсуває всі стовпці узгоджено
+TEST(EnemyStoreLogic, RemoveKeepsColumnsAligned) {
+    EnemyStore enemies;
+    enemies.add(EnemyType::Zombie, "Z1", 50, 10, 0, 1, 1);
+    enemies.add(EnemyType::Boss, "B1", 120, 20, 7, 5, 6);
+    enemies.add(EnemyType::Zombie, "Z2", 40, 10, 0, 3, 4);
+
+    Player player("Hero", 100, 20, 0, 0);
+    player.chooseWeapon(1);
+    enemies.takeDamage(0, player.strike());
+    ASSERT_FALSE(enemies.isAlive(0));
+    enemies.remove(0);
+
+    ASSERT_EQ(enemies.size(), 2u);
+    ASSERT_EQ(enemies.getName(0), "Z2");
+    ASSERT_EQ(enemies.getHealth(0), 40);
+    ASSERT_EQ(enemies.getX(0), 3);
+    ASSERT_EQ(enemies.getY(0), 4);
+    ASSERT_EQ(enemies.getName(1), "B1");
+    ASSERT_EQ(enemies.getType(1), EnemyType::Boss);
+    ASSERT_EQ(enemies.getAttackDamage(1), 27);
+}
+
+// Тест 45: Дескриптор ворога переживає видалення інших і стає недійсним після смерті
+TEST(EnemyStoreLogic, HandlesStayValidAcrossRemovals) {
+    EnemyStore enemies;
+    EnemyHandle a = enemies.add(EnemyType::Zombie, "A", 50, 10, 0, 1, 1);
+    EnemyHandle b = enemies.add(EnemyType::Zombie, "B", 50, 10, 0, 2, 2);
+    EnemyHandle c = enemies.add(EnemyType::Boss, "C", 90, 20, 7, 3, 3);
+
+    ASSERT_TRUE(enemies.remove(a));
+    ASSERT_FALSE(enemies.contains(a));
+    ASSERT_FALSE(enemies.remove(a));
+    ASSERT_EQ(enemies.getName(enemies.find(b)), "B");
+    ASSERT_EQ(enemies.getName(enemies.find(c)), "C");
+
+    // Слот A використовується повторно, але старий дескриптор не оживає
+    EnemyHandle d = enemies.add(EnemyType::Zombie, "D", 50, 10, 0, 4, 4);
+    ASSERT_EQ(d.index, a.index);
+    ASSERT_EQ(enemies.find(a), EnemyStore::npos);
+    ASSERT_EQ(enemies.getName(enemies.find(d)), "D");
+}
+
+// Тест 46: Контейнер видаляє за O(1) і повертає стабільні дескриптори
+TEST(ContainerLogic, HandlesSurviveSwapRemove) {
+    Container<Entity> container;
+    SlotHandle z1 = container.add(make_unique<Zombie>("Z1", 10, 1, 0, 0));
+    SlotHandle z2 = container.add(make_unique<Zombie>("Z2", 10, 1, 0, 0));
+    SlotHandle b1 = container.add(make_unique<Boss>("B1", 100, 10, 5, 0, 0));
+
+    container.remove(z1);
+    ASSERT_EQ(container.size(), 2u);
+    ASSERT_EQ(container.get(z1), nullptr);
+    ASSERT_EQ(container.get(z2)->getName(), "Z2");
+    ASSERT_EQ(container.get(b1)->getName(), "B1");
+    ASSERT_EQ(container.get(0)->getName(), "B1");
+}
+
+// Тест 47: Перегляди контейнера обходять об'єкти без копіювання і фільтрують за типом
+TEST(ContainerLogic, ViewsIterateAndFilterByType) {
+    Container<Entity> container;
+    container.add(make_unique<Zombie>("Z1", 10, 1, 0, 0));
+    container.add(make_unique<Boss>("B1", 100, 10, 5, 0, 0));
+    container.add(make_unique<Zombie>("Z2", 10, 1, 0, 0));
+
+    vector<string> all;
+    for (Entity* e : container.all()) all.push_back(e->getName());
+    ASSERT_EQ(all, (vector<string>{"Z1", "B1", "Z2"}));
+
+    // Boss успадковує Zombie, тож теж потрапляє у "всіх зомбі"
+    vector<string> zombies;
+    for (Zombie* z : container.ofType<Zombie>()) zombies.push_back(z->getName());
+    ASSERT_EQ(zombies, (vector<string>{"Z1", "B1", "Z2"}));
+
+    int bosses = 0;
+    for (Boss* b : container.ofType<Boss>()) {
+        ASSERT_EQ(b->getName(), "B1");
+        ++bosses;
+    }
+    ASSERT_EQ(bosses, 1);
+
+    Container<Entity> empty;
+    ASSERT_TRUE(empty.all().empty());
+    ASSERT_TRUE(empty.ofType<Zombie>().empty());
+}
+
+// Тест 48: Зомбі приймає перегляд контейнера замість вектора вказівників
+TEST(ZombieAI, ZombieBlockedByEnemyFromContainerView) {
+    TileGrid grid = {{0, 0, 0, 0, 0}};
+    Container<Entity> container;
+    container.add(make_unique<Zombie>("Z1", 50, 10, 1, 0));
+    container.add(make_unique<Zombie>("Z2", 50, 10, 2, 0));
+
+    Zombie* z1 = static_cast<Zombie*>(container.get((size_t)0));
+    z1->moveTowards(4, 0, grid, container.ofType<Zombie>());
+    ASSERT_EQ(z1->getX(), 1);
+}
+
+// Тест 49: EnemyStore перебирає індекси ворогів лише потрібного типу
+TEST(EnemyStoreLogic, OfTypeVisitsOnlyMatchingEnemies) {
+    EnemyStore enemies;
+    enemies.add(EnemyType::Zombie, "Z1", 50, 10, 0, 0, 0);
+    enemies.add(EnemyType::Boss, "B1", 120, 20, 7, 1, 0);
+    enemies.add(EnemyType::Zombie, "Z2", 50, 10, 0, 2, 0);
+    enemies.add(EnemyType::Boss, "B2", 120, 20, 7, 3, 0);
+
+    vector<size_t> bosses(enemies.ofType(EnemyType::Boss).begin(), enemies.ofType(EnemyType::Boss).end());
+    ASSERT_EQ(bosses, (vector<size_t>{1, 3}));
+
+    vector<string> zombies;
+    for (size_t i : enemies.ofType(EnemyType::Zombie)) zombies.push_back(enemies.getName(i));
+    ASSERT_EQ(zombies, (vector<string>{"Z1", "Z2"}));
+}
+
+// Тест 50: Тег виду замінює dynamic_cast і враховує, що бос — теж зомбі
+TEST(EntityKindLogic, EntityCastUsesKindTag) {
+    Zombie zombie("Z", 50, 10, 0, 0);
+    Boss boss("B", 100, 10, 5, 0, 0);
+    Player player("P", 100, 10, 0, 0);
+
+    ASSERT_EQ(zombie.getKind(), EntityKind::Zombie);
+    ASSERT_EQ(boss.getKind(), EntityKind::Boss);
+    ASSERT_EQ(player.getKind(), EntityKind::Player);
+
+    Entity* e = &boss;
+    ASSERT_EQ(entity_cast<Boss>(e), &boss);
+    ASSERT_EQ(entity_cast<Zombie>(e), static_cast<Zombie*>(&boss));
+    ASSERT_EQ(entity_cast<Player>(e), nullptr);
+
+    const Entity* z = &zombie;
+    ASSERT_EQ(entity_cast<Boss>(z), nullptr);
+    ASSERT_EQ(entity_cast<Zombie>(z), &zombie);
+    ASSERT_EQ(entity_cast<Zombie>((Entity*)nullptr), nullptr);
+}
+
+// Тест 51: Асинхронний логер приймає повідомлення з кількох потоків і нічого не губить
+TEST(LoggerLogic, AsyncLoggerWritesAllMessagesAfterFlush) {
+    Logger& logger = Logger::getInstance();
+    logger.flush();
+
+    const int threadCount = 4;
+    const int perThread = 500;
+    vector<thread> producers;
+    for (int t = 0; t < threadCount; ++t) {
+        producers.emplace_back([t, perThread] {
+            for (int i = 0; i < perThread; ++i) {
+                LOG_DEBUG("async-logger-test " + to_string(t) + " " + to_string(i));
+            }
+        });
+    }
+    for (auto& producer : producers) producer.join();
+    logger.flush();
+
+    ifstream log("game_log.txt");
+    ASSERT_TRUE(log.is_open());
+    int found = 0;
+    string line;
+    while (getline(log, line)) {
+        if (line.find("[DEBUG] async-logger-test ") != string::npos) ++found;
+    }
+    ASSERT_EQ(found, threadCount * perThread);
+    ASSERT_EQ(logger.getDroppedCount(), 0u);
+}
+
+// Тест 52: Вимкнений рівень логування не обчислює аргумент повідомлення
+TEST(LoggerLogic, DisabledLevelSkipsMessageConstruction) {
+    int built = 0;
+    auto message = [&built] {
+        ++built;
+        return string("level-filter-test");
+    };
+
+    Logger::setLevel(LogLevel::Warning);
+    LOG_DEBUG(message());
+    LOG_INFO(message());
+    ASSERT_EQ(built, 0);
+    ASSERT_FALSE(Logger::isEnabled(LogLevel::Info));
+    ASSERT_TRUE(Logger::isEnabled(LogLevel::Error));
+
+    LOG_WARN(message());
+    ASSERT_EQ(built, 1);
+
+    Logger::setLevel(LogLevel::Debug);
+    LOG_INFO(message());
+    ASSERT_EQ(built, 2);
+}
+
+// Тест 53: Структурована подія записується у бінарний лог і розкодовується з інтернованими рядками
+TEST(LoggerLogic, BinaryEventRoundTrip) {
+    Logger& logger = Logger::getInstance();
+    logger.flush();
+    logger.setFormat(LogFormat::Binary);
+
+    uint32_t nameId = Logger::intern("Soak Zombie");
+    ASSERT_EQ(Logger::intern("Soak Zombie"), nameId);
+    LOG_EVENT(LogLevel::Info, "entity_takes_damage", LogStr{nameId}, 42);
+    LOG_INFO("binary-text-record");
+    logger.flush();
+    logger.setFormat(LogFormat::Text);
+
+    ifstream file("game_log.bin", ios::binary);
+    ASSERT_TRUE(file.is_open());
+    string data((istreambuf_iterator<char>(file)), istreambuf_iterator<char>());
+
+    BinaryLog::Reader reader(data);
+    BinaryLog::Record record;
+    bool foundEvent = false;
+    bool foundText = false;
+    while (reader.next(record)) {
+        if (record.tag == BinaryLog::TAG_EVENT && reader.stringAt(record.messageId) == "entity_takes_damage"
+            && record.args.size() == 2 && reader.stringAt((uint64_t)record.args[0].value) == "Soak Zombie") {
+            ASSERT_EQ(record.args[1].type, BinaryLog::ArgType::Int);
+            ASSERT_EQ(record.args[1].value, 42);
+            foundEvent = true;
+        }
+        if (record.tag == BinaryLog::TAG_TEXT && record.text == "binary-text-record") foundText = true;
+    }
+    ASSERT_TRUE(reader.isValid());
+    ASSERT_TRUE(foundEvent);
+    ASSERT_TRUE(foundText);
+}
+
+// Тест 54: Varint і zigzag кодують від'ємні та великі числа без втрат
+TEST(LoggerLogic, VarintRoundTrip) {
+    for (int64_t v : {0LL, 1LL, -1LL, 300LL, -123456789LL, (long long)INT64_MAX, (long long)INT64_MIN}) {
+        string buf;
+        BinaryLog::putVarint(buf, BinaryLog::zigzag(v));
+        const uint8_t* p = (const uint8_t*)buf.data();
+        uint64_t decoded;
+        ASSERT_TRUE(BinaryLog::getVarint(p, p + buf.size(), decoded));
+        ASSERT_EQ(BinaryLog::unzigzag(decoded), v);
+    }
+}
+
+// Тест 55: Самописець пам'ятає останні події навіть з вимкненим виводом
+TEST(LoggerLogic, FlightRecorderKeepsRecentEventsWithSinksOff) {
+    Logger& logger = Logger::getInstance();
+    logger.flush();
+    logger.setFormat(LogFormat::Off);
+
+    uint32_t nameId = Logger::intern("Recorder Zombie");
+    LOG_EVENT(LogLevel::Info, "entity_takes_damage", LogStr{nameId}, 7);
+    for (size_t i = 0; i < FlightRecorder::CAPACITY; ++i) {
+        LOG_INFO("flight-recorder-test " + to_string(i));
+    }
+    logger.setFormat(LogFormat::Text);
+
+    vector<string> lines = logger.recentEvents();
+    ASSERT_EQ(lines.size(), FlightRecorder::CAPACITY);
+    // Найстаріша подія витіснена, остання — на місці
+    ASSERT_EQ(lines.front().find("Recorder Zombie"), string::npos);
+    ASSERT_NE(lines.back().find("[INFO] flight-recorder-test " + to_string(FlightRecorder::CAPACITY - 1)), string::npos);
+
+    LOG_EVENT(LogLevel::Warning, "entity_takes_damage", LogStr{nameId}, 7);
+    ostringstream dump;
+    logger.dumpFlightRecorder(dump);
+    // Текст залежить від того, чи завантажено шаблони мови, але ім'я й число є завжди
+    vector<string> dumped = logger.recentEvents();
+    ASSERT_NE(dumped.back().find("[WARN] "), string::npos);
+    ASSERT_NE(dumped.back().find("Recorder Zombie"), string::npos);
+    ASSERT_NE(dumped.back().find('7'), string::npos);
+    ASSERT_NE(dump.str().find(dumped.back()), string::npos);
+}
+
+// Тест 56: Довгий текст у самописці обрізається, а не виділяє пам'ять
+TEST(LoggerLogic, FlightRecorderTruncatesLongText) {
+    FlightRecorder recorder;
+    recorder.recordText(0, string(500, 'x'));
+    vector<FlightRecorder::Entry> entries = recorder.snapshot();
+    ASSERT_EQ(entries.size(), 1u);
+    ASSERT_EQ(entries[0].textLength, FlightRecorder::TEXT_SIZE);
+    ASSERT_FALSE(entries[0].isEvent);
+    ASSERT_EQ(recorder.totalRecorded(), 1u);
+}
+
+// Тест 57: Попередньо розібрані шаблони підставляють аргументи в будь-якому порядку
+TEST(LocalizationManager, PreparsedTemplatesFormatArguments) {
+    LocalizationManager& lm = LocalizationManager::getInstance();
+    const char* filename = "fmt_test.json";
+    {
+        std::ofstream tempFile(filename);
+        tempFile << R"({"swap": "{1} <- {0}", "repeat": "{0}{0}", "missing": "a {0} b {2}", "plain": "{x} {}",)"
+                   R"("huge": "{99999999999} {0}"})";
+    }
+    ASSERT_TRUE(lm.loadLanguage("fmt_test"));
+    std::remove(filename);
+
+    ASSERT_EQ(lm.getFormattedString("swap", "Zombie", 15).toAnsiString(), "15 <- Zombie");
+    ASSERT_EQ(lm.getFormattedString("repeat", -7).toAnsiString(), "-7-7");
+    // Плейсхолдер без аргументу лишається як є
+    ASSERT_EQ(lm.getFormattedString("missing", string("x")).toAnsiString(), "a x b {2}");
+    ASSERT_EQ(lm.getFormattedString("plain", 1).toAnsiString(), "{x} {}");
+    // Номер, що не влазить в int32_t, лишається текстом, а не стає аргументом 0
+    ASSERT_EQ(lm.getFormattedString("huge", "x").toAnsiString(), "{99999999999} x");
+    ASSERT_EQ(lm.getString("swap").toAnsiString(), "{1} <- {0}");
+    ASSERT_EQ(lm.getFormattedString("nope", 1).toAnsiString(), "!!nope!!");
+
+    lm.loadLanguage("en");
+}
+
+// Тест 58: Ключ, перетворений на id під час компіляції, дає той самий текст, що й рядковий ключ
+TEST(LocalizationManager, CompileTimeKeyMatchesStringKey) {
+    LocalizationManager& lm = LocalizationManager::getInstance();
+    ASSERT_TRUE(lm.loadLanguage("en"));
+
+    constexpr L10nId title = l10nKey("game_title");
+    static_assert(L10nKeys::names[title.index] == "game_title");
+    ASSERT_EQ(lm.getString(title).toAnsiString(), lm.getString("game_title").toAnsiString());
+    ASSERT_EQ(lm.getFormattedString(l10nKey("config_enemies"), 5).toAnsiString(),
+              lm.getFormattedString("config_enemies", 5).toAnsiString());
+
+    // Мова без ключа: id-шлях повертає ту саму позначку, що й рядковий
+    const char* filename = "partial_test.json";
+    {
+        std::ofstream tempFile(filename);
+        tempFile << R"({"menu_exit": "Bye"})";
+    }
+    ASSERT_TRUE(lm.loadLanguage("partial_test"));
+    std::remove(filename);
+    ASSERT_EQ(lm.getString(l10nKey("menu_exit")).toAnsiString(), "Bye");
+    ASSERT_EQ(lm.getString(title).toAnsiString(), "!!game_title!!");
+
+    lm.loadLanguage("en");
+}
+
+
+// Тест 59: Форматовані рядки кешуються, кирилиця декодується, кеш скидається при зміні мови
+TEST(LocalizationManager, FormattedStringsAreCachedPerLanguage) {
+    LocalizationManager& lm = LocalizationManager::getInstance();
+    const char* filename = "cache_test.json";
+    {
+        std::ofstream tempFile(filename);
+        tempFile << R"({"config_enemies": "Ворогів: {0}", "menu_exit": "Вихід"})";
+    }
+    ASSERT_TRUE(lm.loadLanguage("cache_test"));
+    ASSERT_EQ(lm.formattedCacheSize(), 0u);
+
+    sf::String first = lm.getFormattedString("config_enemies", 7);
+    sf::String second = lm.getFormattedString(l10nKey("config_enemies"), 7);
+    ASSERT_EQ(lm.formattedCacheSize(), 1u);
+    ASSERT_TRUE(first == second);
+    std::basic_string<sf::Uint32> expected = {0x412, 0x43E, 0x440, 0x43E, 0x433, 0x456, 0x432, ':', ' ', '7'};
+    ASSERT_TRUE(first.toUtf32() == expected);
+    ASSERT_EQ(lm.getString("menu_exit").getSize(), 5u);
+
+    lm.getFormattedString("config_enemies", 8);
+    ASSERT_EQ(lm.formattedCacheSize(), 2u);
+
+    std::remove(filename);
+    ASSERT_TRUE(lm.loadLanguage("en"));
+    ASSERT_EQ(lm.formattedCacheSize(), 0u);
+    ASSERT_EQ(lm.getFormattedString("config_enemies", 7).toAnsiString(), "Enemies: 7");
+}
+
+
+// Тест 60: Мова розбирається у фоні й публікується атомарно; помилка не змінює поточну мову
+TEST(LocalizationManager, AsyncLanguageSwitchPublishesWhenReady) {
+    LocalizationManager& lm = LocalizationManager::getInstance();
+    ASSERT_TRUE(lm.loadLanguage("en"));
+    const char* filename = "async_test.json";
+    {
+        std::ofstream tempFile(filename);
+        tempFile << R"({"menu_exit": "Async exit"})";
+    }
+
+    uint64_t before = lm.getGeneration();
+    lm.preloadLanguages({"async_test"});
+    lm.waitForPendingLoads();
+    ASSERT_EQ(lm.getGeneration(), before); // Попереднє завантаження не перемикає мову
+    ASSERT_EQ(lm.getLanguage(), "en");
+
+    std::remove(filename); // Пакет уже в пам'яті — файл більше не потрібен
+    lm.loadLanguageAsync("async_test");
+    ASSERT_EQ(lm.getGeneration(), before + 1);
+    ASSERT_EQ(lm.getString("menu_exit").toAnsiString(), "Async exit");
+
+    lm.loadLanguageAsync("no_such_language");
+    lm.waitForPendingLoads();
+    ASSERT_FALSE(lm.isLoading());
+    ASSERT_EQ(lm.getLanguage(), "async_test");
+
+    lm.loadLanguageAsync("en");
+    ASSERT_EQ(lm.getString("menu_exit").toAnsiString(), "Exit");
+}
+
+
+// Тест 61: Мова завантажується з бінарного пакета без JSON; пошкоджений пакет відкидається
+TEST(LocalizationManager, LoadsLanguageFromMappedBundle) {
+    LanguageBundle::Builder builder;
+    builder.add("menu_exit", "Вихід");
+    builder.add("config_enemies", "Enemies: {0}, boss {1}");
+    std::string bytes = builder.build();
+
+    LanguageBundle::View view;
+    ASSERT_TRUE(view.open(bytes.data(), bytes.size()));
+    ASSERT_EQ(view.size(), 2u);
+    const LanguageBundle::Entry* exit = view.find("menu_exit");
+    ASSERT_NE(exit, nullptr);
+    ASSERT_EQ(exit->u32Length, 5u);
+    ASSERT_EQ(view.find("missing_key"), nullptr);
+    ASSERT_FALSE(view.open(bytes.data(), bytes.size() - 1));
+
+    const char* filename = "bundle_test.l10n";
+    {
+        std::ofstream out(filename, std::ios::binary);
+        out.write(bytes.data(), (std::streamsize)bytes.size());
+    }
+    LocalizationManager& lm = LocalizationManager::getInstance();
+    ASSERT_TRUE(lm.loadLanguage("bundle_test"));
+    ASSERT_EQ(lm.getString(l10nKey("menu_exit")).getSize(), 5u);
+    ASSERT_EQ(lm.getFormattedString("config_enemies", 3, "no").toAnsiString(), "Enemies: 3, boss no");
+
+    // Пакет "bundle_test" лишається відображеним у кеші менеджера, тож пошкоджений
+    // пишемо в окремий файл: обрізати відображений файл на місці не можна
+    const char* corruptName = "bundle_corrupt_test.l10n";
+    {
+        std::ofstream out(corruptName, std::ios::binary | std::ios::trunc);
+        out.write(bytes.data(), 10); // Обрізаний пакет, а JSON немає
+    }
+    ASSERT_FALSE(lm.loadLanguage("bundle_corrupt_test"));
+    std::remove(corruptName);
+    std::remove(filename);
+
+    lm.loadLanguage("en");
+}
+
+
+// Тест 62: Шар тайлів патчиться на місці — підбір предмета не додає вершин, звільнене місце перевикористовується
+TEST(TileLayerLogic, UpdateTilePatchesVerticesInPlace) {
+    TileGrid grid = {
+        {1, 1, 1},
+        {1, 2, 1},
+        {1, 1, 1}
+    };
+    sf::Texture atlas;
+    TileLayer layer;
+    layer.build(grid.view(), atlas, {0, 0, 32, 32}, {33, 0, 32, 32}, {66, 0, 2, 2});
+    size_t built = layer.getVertexCount();
+    ASSERT_EQ(built, 4u + 8u * 4u + 48u); // Підлога під зіллям, 8 стін, коло зілля
+
+    grid.set(1, 1, TILE_FLOOR); // Як Map::clearTile
+    layer.updateTile(1, 1, grid.view());
+    ASSERT_EQ(layer.getVertexCount(), built);
+
+    grid.set(1, 1, TILE_AMMO);
+    layer.updateTile(1, 1, grid.view());
+    size_t withAmmo = layer.getVertexCount();
+    ASSERT_EQ(withAmmo, built + 8u);
+
+    grid.set(1, 1, TILE_POTION); // Місце зілля вже є — шар не росте
+    layer.updateTile(1, 1, grid.view());
+    ASSERT_EQ(layer.getVertexCount(), withAmmo);
+}
+
+
+// Тест 63: Атлас розкладає спрайти без перетинів у межах ширини, батч збирає всі спрайти в один масив
+TEST(TextureAtlasLogic, PacksSpritesWithoutOverlap) {
+    std::vector<sf::Vector2u> sizes = {{32, 32}, {64, 16}, {16, 48}, {40, 40}, {2, 2}};
+    sf::Vector2u total;
+    std::vector<sf::Vector2u> pos = TextureAtlas::pack(sizes, 100, total);
+    ASSERT_EQ(pos.size(), sizes.size());
+    for (size_t i = 0; i < sizes.size(); ++i) {
+        ASSERT_LE(pos[i].x + sizes[i].x, total.x);
+        ASSERT_LE(pos[i].y + sizes[i].y, total.y);
+        ASSERT_LE(pos[i].x + sizes[i].x, 100u);
+        for (size_t j = i + 1; j < sizes.size(); ++j) {
+            bool apart = pos[i].x + sizes[i].x <= pos[j].x || pos[j].x + sizes[j].x <= pos[i].x ||
+                         pos[i].y + sizes[i].y <= pos[j].y || pos[j].y + sizes[j].y <= pos[i].y;
+            ASSERT_TRUE(apart) << "sprites " << i << " and " << j << " overlap";
+        }
+    }
+
+    sf::Texture texture;
+    SpriteBatch batch;
+    batch.begin(texture);
+    for (int i = 0; i < 100; ++i) batch.add({0, 0, 32, 32}, {i * 32.f, 0.f}, {32.f, 32.f});
+    ASSERT_EQ(batch.getSpriteCount(), 100u);
+    batch.begin(texture);
+    ASSERT_EQ(batch.getSpriteCount(), 0u);
+}
+
+
+// Тест 64: Видимий прямокутник обрізається картою, а ворогів у ньому знаходять через шар зайнятості
+TEST(CullingLogic, VisibleTilesAndOccupancyLookup) {
+    sf::View view({400.f, 300.f}, {800.f, 600.f});
+    sf::IntRect visible = TileLayer::visibleTiles(view, 1000, 1000);
+    ASSERT_EQ(visible, sf::IntRect(0, 0, 25, 19)); // 800/32 = 25, ceil(600/32) = 19
+
+    sf::View far({32.f * 995, 32.f * 500}, {800.f, 600.f});
+    sf::IntRect clipped = TileLayer::visibleTiles(far, 1000, 1000);
+    ASSERT_EQ(clipped.left + clipped.width, 1000);
+    ASSERT_LT(clipped.width, 25);
+
+    EnemyStore enemies;
+    OccupancyGrid occupancy(10, 10);
+    EnemyHandle a = enemies.add(EnemyType::Zombie, "A", 50, 10, 0, 2, 2);
+    EnemyHandle b = enemies.add(EnemyType::Boss, "B", 200, 30, 15, 5, 5);
+    occupancy.place((int32_t)a.index, 2, 2);
+    occupancy.place((int32_t)b.index, 5, 5);
+
+    enemies.remove(a); // Бос переїжджає на індекс 0
+    occupancy.remove(2, 2);
+    size_t i = enemies.findBySlot((uint32_t)occupancy.occupantAt(5, 5));
+    ASSERT_EQ(i, 0u);
+    ASSERT_EQ(enemies.getType(i), EnemyType::Boss);
+    ASSERT_EQ(enemies.findBySlot(a.index), EnemyStore::npos);
+}
+
+// Тест 65: Симуляція без вікна детермінована — те саме зерно й ті самі дії дають ту саму гру
+TEST(SimulationLogic, SameSeedAndActionsGiveSameGame) {
+    SimConfig config;
+    config.mapWidth = 20;
+    config.mapHeight = 20;
+    config.enemyCount = 5;
+
+    const PlayerAction script[] = {PlayerAction::MoveRight, PlayerAction::MoveDown, PlayerAction::Attack,
+                                   PlayerAction::SwapWeapon, PlayerAction::MoveRight, PlayerAction::Attack};
+    auto play = [&](Simulation& sim) {
+        sim.reset(config, 777);
+        for (int t = 0; t < 60 && !sim.isOver(); ++t) sim.act(script[t % 6]);
+    };
+
+    Simulation a, b;
+    play(a);
+    play(b);
+    ASSERT_EQ(a.getTurn(), b.getTurn());
+    ASSERT_EQ(a.getStatus(), b.getStatus());
+    ASSERT_EQ(a.getPlayer().getHealth(), b.getPlayer().getHealth());
+    ASSERT_EQ(a.getPlayer().getX(), b.getPlayer().getX());
+    ASSERT_EQ(a.getPlayer().getY(), b.getPlayer().getY());
+    ASSERT_EQ(a.getEnemies().size(), b.getEnemies().size());
+    for (size_t i = 0; i < a.getEnemies().size(); ++i) {
+        ASSERT_EQ(a.getEnemies().getXs()[i], b.getEnemies().getXs()[i]);
+        ASSERT_EQ(a.getEnemies().getYs()[i], b.getEnemies().getYs()[i]);
+    }
+}
+
+// Тест 66: Хід розв'язується повністю: зміна зброї не витрачає хід, ворог поруч б'є у відповідь, гра закінчується
+TEST(SimulationLogic, TurnsResolveUntilGameEnds) {
+    SimConfig config;
+    config.enemyCount = 1; // Лише бос у дальньому куті
+    Simulation sim;
+    sim.reset(config, 42);
+    ASSERT_EQ(sim.getEnemies().size(), 1u);
+    ASSERT_EQ(sim.getStatus(), SimStatus::Running);
+
+    ASSERT_TRUE(sim.act(PlayerAction::SwapWeapon));
+    ASSERT_EQ(sim.getTurn(), 0);
+    ASSERT_EQ(sim.getEvents().size(), 1u);
+    ASSERT_EQ(sim.getEvents()[0].type, SimEvent::Type::WeaponSwapped);
+    ASSERT_EQ(sim.getEvents()[0].name, "Gun");
+    sim.act(PlayerAction::SwapWeapon); // Назад до меча, щоб бос підійшов впритул
+    ASSERT_EQ(sim.getTurn(), 0);
+
+    // Стоїмо з мечем і чекаємо: бос дійде сам і рано чи пізно або загине, або вб'є гравця
+    bool enemyHit = false;
+    for (int t = 0; t < 500 && !sim.isOver(); ++t) {
+        sim.act(PlayerAction::Attack);
+        for (const SimEvent& e : sim.getEvents()) {
+            if (e.type == SimEvent::Type::EnemyHitsPlayer) enemyHit = true;
+        }
+    }
+    ASSERT_TRUE(sim.isOver());
+    ASSERT_TRUE(enemyHit);
+    ASSERT_FALSE(sim.act(PlayerAction::MoveRight)); // Після кінця гри дії ігноруються
+    if (sim.getStatus() == SimStatus::Victory) {
+        ASSERT_EQ(sim.getEnemies().size(), 0u);
+        ASSERT_EQ(sim.getPlayer().getScore(), 50);
+    } else {
+        ASSERT_FALSE(sim.getPlayer().isAlive());
+    }
+}
+
+// Тест 67: Пакетний прогін на кількох потоках дає ті самі результати, що й по одній грі
+TEST(SimulationLogic, BatchRunMatchesSequentialGames) {
+    vector<SimBatch::Job> jobs;
+    for (uint64_t g = 0; g < 24; ++g) {
+        SimConfig config;
+        config.enemyCount = 2 + (int)(g % 3);
+        config.weapon = (g % 2) ? 2 : 1;
+        jobs.push_back({config, SimBatch::gameSeed(9, g)});
+    }
+
+    vector<SimBatch::GameResult> results = SimBatch::run(jobs, 4, 300);
+    ASSERT_EQ(results.size(), jobs.size());
+
+    Simulation sim;
+    for (size_t i = 0; i < jobs.size(); ++i) {
+        SimBatch::GameResult expected = SimBatch::playGame(sim, jobs[i], 300);
+        ASSERT_EQ(results[i].status, expected.status);
+        ASSERT_EQ(results[i].turns, expected.turns);
+        ASSERT_EQ(results[i].damageTaken, expected.damageTaken);
+        ASSERT_EQ(results[i].score, expected.score);
+    }
+
+    SimBatch::Summary summary = SimBatch::summarize(results, 0, results.size());
+    ASSERT_EQ(summary.games, jobs.size());
+    ASSERT_EQ(summary.wins + summary.defeats + summary.timeouts, jobs.size());
+    ASSERT_GT(summary.wins, 0u); // Скриптований гравець справляється хоча б з частиною ігор
+    ASSERT_LE(summary.turns.p10, summary.turns.p50);
+    ASSERT_LE(summary.turns.p90, summary.turns.max);
+}
+
+// Тест 68: Вороги, як і раніше, не стають на зілля й патрони, а після підбору клітинка відкривається
+TEST(FlowFieldLogic, EnemiesWalkOnlyOnFloor) {
+    TileGrid grid = {
+        {0, 2, 0},
+        {1, 3, 1},
+        {0, 0, 0}
+    };
+    FlowField field;
+    field.compute(0, 0, grid);
+    ASSERT_EQ(field.distanceAt(1, 0), FlowField::UNREACHABLE);
+    ASSERT_EQ(field.distanceAt(2, 0), FlowField::UNREACHABLE);
+
+    EnemyStore enemies;
+    enemies.add(EnemyType::Zombie, "Walker", 50, 10, 0, 2, 0);
+    OccupancyGrid occupancy(3, 3);
+    occupancy.place(0, 2, 0);
+    enemies.moveTowards(0, field, occupancy);
+    ASSERT_EQ(enemies.getX(0), 2); // Зілля не пропускає
+    ASSERT_EQ(enemies.getY(0), 0);
+
+    grid.set(1, 0, TILE_FLOOR); // Гравець підібрав зілля
+    field.updateTile(1, 0, grid);
+    ASSERT_EQ(field.distanceAt(2, 0), 2);
+    enemies.moveTowards(0, field, occupancy);
+    ASSERT_EQ(enemies.getX(0), 1);
+}
+
+// Тест 69: Імена ворогів інтернуються лише тоді, коли подія з ними справді пишеться в лог
+TEST(LoggerLogic, EnemyNamesAreInternedLazily) {
+    Logger::intern("entity_takes_damage"); // Ключ події інтернується окремо, при першому записі
+    Logger::setLevel(LogLevel::Error);
+    size_t before = Logger::internedCount();
+    EnemyStore enemies;
+    for (int i = 0; i < 50; ++i) {
+        enemies.add(EnemyType::Zombie, "Lazy Zombie " + to_string(i), 50, 10, 0, i, 0);
+    }
+    Zombie zombie("Lazy Walker", 50, 10, 1, 1);
+    Player player("Lazy Hero", 100, 20, 0, 0);
+    enemies.attack(0, player);
+    enemies.takeDamage(1, 5);
+    ASSERT_EQ(Logger::internedCount(), before);
+
+    Logger::setLevel(LogLevel::Debug);
+    enemies.takeDamage(1, 5); // Тепер ім'я потрібне логу
+    ASSERT_EQ(Logger::internedCount(), before + 1);
+    ASSERT_EQ(zombie.getNameId(), Logger::intern("Lazy Walker"));
+    ASSERT_NE(zombie.getNameId(), Logger::NOT_INTERNED);
+}
+
+// Тест 70: Шаблон логу приймає багатоцифрові номери аргументів, як і мовний пакет
+TEST(BinaryLogLogic, TemplateSupportsMultiDigitPlaceholders) {
+    auto arg = [](size_t n) { return "a" + to_string(n); };
+    ASSERT_EQ(BinaryLog::fillTemplate("{10} after {1}", 11, arg), "a10 after a1");
+    ASSERT_EQ(BinaryLog::fillTemplate("{11} {x} {} {2", 11, arg), "{11} {x} {} {2");
+    ASSERT_EQ(BinaryLog::fillTemplate("{0}{0}", 1, arg), "a0a0");
+}
+
+// Тест 71: Аварійний дамп — сирі записи самописця, які розкодовує BinaryLog::Reader
+TEST(LoggerLogic, CrashDumpDecodesAsBinaryLog) {
+    const char* filename = "crash_dump_test.bin";
+    Logger& logger = Logger::getInstance();
+    Logger::installCrashHandler(filename);
+
+    uint32_t nameId = Logger::intern("Crash Dump Zombie");
+    LOG_EVENT(LogLevel::Warning, "entity_takes_damage", LogStr{nameId}, 13);
+    // Повторний дамп перезаписує файл, а не дописує в кінець
+    ASSERT_TRUE(logger.writeCrashDump());
+    ASSERT_TRUE(logger.writeCrashDump(SIGSEGV));
+
+    string data;
+    {
+        ifstream file(filename, ios::binary);
+        ASSERT_TRUE(file.is_open());
+        data.assign((istreambuf_iterator<char>(file)), istreambuf_iterator<char>());
+    }
+    std::remove(filename);
+
+    BinaryLog::Reader reader(data);
+    BinaryLog::Record record;
+    vector<BinaryLog::Record> records;
+    while (reader.next(record)) records.push_back(record);
+    ASSERT_TRUE(reader.isValid());
+    ASSERT_GE(records.size(), 2u);
+
+    const BinaryLog::Record& event = records[records.size() - 2];
+    ASSERT_EQ(event.tag, BinaryLog::TAG_EVENT);
+    ASSERT_EQ(event.level, (uint8_t)LogLevel::Warning);
+    ASSERT_EQ(reader.stringAt(event.messageId), "entity_takes_damage");
+    ASSERT_EQ(event.args.size(), 2u);
+    ASSERT_EQ(reader.stringAt((uint64_t)event.args[0].value), "Crash Dump Zombie");
+    ASSERT_EQ(event.args[1].value, 13);
+
+    ASSERT_EQ(records.back().tag, BinaryLog::TAG_TEXT);
+    ASSERT_EQ(records.back().text, "Crash: signal " + to_string(SIGSEGV));
+}
+
+// Тест 72: Аргументи char, const char* і дробові форматуються так само, як через ostream
+TEST(LocalizationManager, FormatMatchesStreamForCharsAndFloats) {
+    LocalizationManager& lm = LocalizationManager::getInstance();
+    const char* filename = "fmt_types_test.json";
+    {
+        std::ofstream tempFile(filename);
+        tempFile << R"({"pair": "{0}|{1}"})";
+    }
+    ASSERT_TRUE(lm.loadLanguage("fmt_types_test"));
+    std::remove(filename);
+
+    auto streamed = [](const auto& a, const auto& b) {
+        ostringstream ss;
+        ss << a << '|' << b;
+        return ss.str();
+    };
+    const char* name = "Boss";
+    ASSERT_EQ(lm.getFormattedString("pair", 'P', name).toAnsiString(), "P|Boss");
+    ASSERT_EQ(lm.getFormattedString("pair", 'P', name).toAnsiString(), streamed('P', name));
+    for (double v : {1.5, 0.1, 1.0 / 3.0, 1234567.0, 1e-7, -2.0}) {
+        ASSERT_EQ(lm.getFormattedString("pair", v, 2.5f).toAnsiString(), streamed(v, 2.5f));
+    }
+    ASSERT_EQ(lm.getFormattedString("pair", 1.0 / 3.0, 1234567.0).toAnsiString(), "0.333333|1.23457e+06");
+
+    lm.loadLanguage("en");
+}
+
+// Тест 73: Пакет, старіший за відредагований JSON, не перекриває його
+TEST(LocalizationManager, StaleBundleFallsBackToNewerJson) {
+    LocalizationManager& lm = LocalizationManager::getInstance();
+    const char* jsonName = "stale_test.json";
+    const char* bundleName = "stale_test.l10n";
+    {
+        LanguageBundle::Builder builder;
+        builder.add("menu_exit", "Old");
+        string bytes = builder.build();
+        std::ofstream out(bundleName, std::ios::binary);
+        out.write(bytes.data(), (std::streamsize)bytes.size());
+    }
+    {
+        std::ofstream out(jsonName);
+        out << R"({"menu_exit": "New"})";
+    }
+    auto now = std::filesystem::file_time_type::clock::now();
+    std::filesystem::last_write_time(bundleName, now - std::chrono::hours(1));
+    std::filesystem::last_write_time(jsonName, now);
+    ASSERT_TRUE(lm.loadLanguage("stale_test"));
+    ASSERT_EQ(lm.getString(l10nKey("menu_exit")).toAnsiString(), "New");
+
+    // Пакет, зібраний після JSON, знову має перевагу
+    std::filesystem::last_write_time(bundleName, now + std::chrono::hours(1));
+    ASSERT_TRUE(lm.loadLanguage("stale_test"));
+    ASSERT_EQ(lm.getString(l10nKey("menu_exit")).toAnsiString(), "Old");
+
+    lm.loadLanguage("en");
+    std::remove(jsonName);
+    std::remove(bundleName);
+}
+
+// Тест 74: Скриптований гравець іде до ворогів через предмети, хоча вороги по них не ходять
+TEST(SimulationLogic, ScriptedPlayerPathsOverItems) {
+    SimConfig config;
+    Simulation sim;
+    bool found = false;
+    for (uint64_t g = 0; g < 200 && !found; ++g) {
+        SimBatch::Job job{config, SimBatch::gameSeed(1, g)};
+        sim.reset(job.config, job.seed);
+        // Шукаємо карту, де до гравця жоден ворог не дійде по підлозі, але гравець до них — дійде
+        const EnemyStore& enemies = sim.getEnemies();
+        bool anyReachesPlayer = false;
+        for (size_t i = 0; i < enemies.size(); ++i) {
+            if (sim.getFlowField().distanceAt(enemies.getXs()[i], enemies.getYs()[i]) != FlowField::UNREACHABLE) {
+                anyReachesPlayer = true;
+            }
+        }
+        if (anyReachesPlayer || SimBatch::stepTowardsNearestEnemy(sim) < 0) continue;
+
+        found = true;
+        ASSERT_TRUE(SimBatch::canProgress(sim));
+        SimBatch::GameResult result = SimBatch::playGame(sim, job, 1000);
+        ASSERT_GT(result.turns, 0);
+        ASSERT_NE(result.status, SimStatus::Running);
+    }
+    ASSERT_TRUE(found);
+}
+
+// Тест 75: Чанки світу збігаються з картою, згенерованою цілком із того ж зерна
+TEST(ChunkedWorldLogic, ChunksMatchEagerMap) {
+    Map eager(300, 250, 20, 777, 1);
+    ChunkedWorld world(300, 250, 20, 777);
+    ASSERT_EQ(world.loadedChunkCount(), 0u);
+
+    TileGrid window(100, 90);
+    world.copyWindow(150, 130, window);
+    ASSERT_EQ(world.loadedChunkCount(), 4u); // Вікно зачіпає 2x2 чанки
+    for (int y = 0; y < 90; ++y) {
+        for (int x = 0; x < 100; ++x) {
+            ASSERT_EQ(window.at(x, y), eager.getGrid().at(150 + x, 130 + y));
+        }
+    }
+    ASSERT_EQ(world.tileAt(299, 5), TILE_WALL);
+    ASSERT_EQ(world.tileAt(-3, 5), TILE_WALL); // Поза світом — стіна
+    ASSERT_EQ(world.tileAt(17, 200), eager.getGrid().at(17, 200));
+    ASSERT_EQ(world.loadedChunkCount(), 4u); // Читання тайла чанк не завантажує
+}
+
+// Тест 76: Далекі незмінені чанки викидаються, а змінені стискаються і повертаються без втрат
+TEST(ChunkedWorldLogic, EvictionDropsCleanAndKeepsDirtyChunks) {
+    ChunkedWorld world(1000, 1000, 20, 5);
+    TileGrid window(128, 128);
+    world.copyWindow(0, 0, window);
+    ASSERT_EQ(world.loadedChunkCount(), 4u);
+    world.setTile(10, 10, TILE_AMMO);
+
+    ASSERT_EQ(world.evictOutside(512, 512, 640, 640), 4u);
+    ASSERT_EQ(world.loadedChunkCount(), 0u);
+    ASSERT_EQ(world.storedChunkCount(), 1u); // Лише змінений чанк
+    ASSERT_LT(world.memoryUsage(), (size_t)ChunkedWorld::CHUNK_SIZE * ChunkedWorld::CHUNK_SIZE);
+    ASSERT_EQ(world.tileAt(10, 10), TILE_AMMO);
+    ASSERT_EQ(world.tileAt(70, 10), world.generatedTile(70, 10));
+
+    TileGrid corner(16, 16);
+    world.copyWindow(0, 0, corner);
+    ASSERT_EQ(corner.at(10, 10), TILE_AMMO);
+    ASSERT_EQ(corner.at(11, 10), world.generatedTile(11, 10));
+    ASSERT_EQ(world.loadedChunkCount(), 1u);
+    ASSERT_EQ(world.storedChunkCount(), 0u);
+}
+
+// Тест 77: На великій карті вікно йде за гравцем, а пам'ять не росте з пройденим шляхом
+TEST(SimulationLogic, LargeMapWindowFollowsPlayer) {
+    SimConfig config;
+    config.mapWidth = 1000;
+    config.mapHeight = 1000;
+    config.wallPercent = 0;
+    config.enemyCount = 1; // Бос у дальньому куті, поза вікном
+    Simulation sim;
+    sim.reset(config, 9);
+
+    const Map& map = sim.getMap();
+    ASSERT_TRUE(map.isChunked());
+    ASSERT_EQ(map.getGrid().getWidth(), Map::WINDOW_SIZE);
+    ASSERT_EQ(sim.getEnemies().size(), 0u);
+    ASSERT_EQ(sim.getDormantEnemies().size(), 1u);
+
+    int windowMoves = 0;
+    for (int step = 0; step < 600; ++step) {
+        sim.act(PlayerAction::MoveRight);
+        for (const SimEvent& e : sim.getEvents()) {
+            if (e.type == SimEvent::Type::WindowMoved) ++windowMoves;
+        }
+        ASSERT_LE(map.getWorld()->loadedChunkCount(), 16u);
+    }
+    ASSERT_EQ(sim.getStatus(), SimStatus::Running); // Сплячий бос — ще не перемога
+    ASSERT_GT(windowMoves, 0);
+    ASSERT_EQ(map.getOriginX() + sim.getPlayer().getX(), 601);
+    ASSERT_EQ(map.getOriginY() + sim.getPlayer().getY(), 1);
+    for (int x = 1; x <= 601; ++x) {
+        ASSERT_EQ(map.tileAt(x, 1), TILE_FLOOR); // Підібрані предмети не відроджуються
+    }
+}
+
+// Тест 78: Сплячий ворог прокидається, коли вікно його накриває, і займає свою клітинку
+TEST(SimulationLogic, DormantEnemyWakesInsideWindow) {
+    SimConfig config;
+    config.mapWidth = 400;
+    config.mapHeight = 40;
+    config.wallPercent = 0;
+    config.enemyCount = 1;
+    Simulation sim;
+    sim.reset(config, 3);
+    ASSERT_EQ(sim.getDormantEnemies().size(), 1u);
+
+    for (int step = 0; step < 400 && sim.getEnemies().size() == 0; ++step) {
+        sim.act(PlayerAction::MoveRight);
+    }
+    const EnemyStore& enemies = sim.getEnemies();
+    ASSERT_EQ(enemies.size(), 1u);
+    ASSERT_TRUE(sim.getDormantEnemies().empty());
+    ASSERT_EQ(enemies.getType(0), EnemyType::Boss);
+    ASSERT_EQ(sim.getOccupancy().occupantAt(enemies.getX(0), enemies.getY(0)), (int32_t)enemies.handleAt(0).index);
+    ASSERT_EQ(sim.getFlowField().distanceAt(sim.getPlayer().getX(), sim.getPlayer().getY()), 0);
+}
+
+/**
+ * @brief Вивантажує самописець у файл, якщо тест впав — щоб бачити контекст збою.
+ */
+class FlightRecorderOnFailure : public testing::EmptyTestEventListener {
+    void OnTestEnd(const testing::TestInfo& info) override {
+        if (info.result()->Failed()) {
+            Logger::getInstance().dumpFlightRecorder(string("flight_recorder_") + info.name() + ".txt");
+        }
+    }
+};
+
+static const bool flightRecorderListenerInstalled = [] {
+    testing::UnitTest::GetInstance()->listeners().Append(new FlightRecorderOnFailure);
+    return true;
+}();
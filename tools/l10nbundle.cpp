@@ -0,0 +1,64 @@
+/**
+ * @file l10nbundle.cpp
+ * @brief Збирає бінарний мовний пакет (*.l10n) з JSON-файлу мови.
+ * @details Використання:
+ *   l10nbundle assets/en.json en.l10n
+ * Гра відображає пакет у пам'ять і не розбирає JSON на старті (див. LanguageBundle.h).
+ * Пакет пишеться у тимчасовий файл і підміняє старий перейменуванням: гра, що саме
+ * відображає старий пакет, не бачить обрізаного файлу (на POSIX це був би SIGBUS).
+ */
+#include <iostream>
+#include <fstream>
+#include <string>
+#include <filesystem>
+#include <system_error>
+#include "../LanguageBundle.h"
+#include "../json.hpp"
+
+using namespace std;
+
+int main(int argc, char* argv[]) {
+    if (argc != 3) {
+        cerr << "Usage: l10nbundle <lang.json> <out.l10n>" << endl;
+        return 2;
+    }
+
+    ifstream input(argv[1]);
+    if (!input.is_open()) {
+        cerr << "Cannot open " << argv[1] << endl;
+        return 1;
+    }
+    nlohmann::json translations;
+    try {
+        translations = nlohmann::json::parse(input);
+    } catch (nlohmann::json::parse_error& e) {
+        cerr << argv[1] << ": " << e.what() << endl;
+        return 1;
+    }
+
+    LanguageBundle::Builder builder;
+    for (auto it = translations.begin(); it != translations.end(); ++it) {
+        if (it->is_string()) builder.add(it.key(), it->get<string>());
+    }
+    string bundle = builder.build();
+
+    string outputPath = argv[2];
+    string tempPath = outputPath + ".tmp";
+    {
+        ofstream output(tempPath, ios::binary | ios::trunc);
+        if (!output.write(bundle.data(), (streamsize)bundle.size()) || !output.flush()) {
+            cerr << "Cannot write " << tempPath << endl;
+            output.close();
+            filesystem::remove(tempPath);
+            return 1;
+        }
+    }
+    error_code error;
+    filesystem::rename(tempPath, outputPath, error);
+    if (error) {
+        cerr << "Cannot replace " << outputPath << ": " << error.message() << endl;
+        filesystem::remove(tempPath, error);
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,127 @@
+/**
+ * @file logdecode.cpp
+ * @brief Перетворює бінарний лог гри (game_log.bin) на текст або JSON.
+ * @details Використання:
+ *   logdecode game_log.bin [--json] [--lang assets/en.json]
+ * Без --lang події виводяться як "ключ: арг, арг"; з --lang ключі підставляються
+ * у шаблони з файлу мови так само, як у текстовому лозі гри.
+ * У режимі --json кожен запис — окремий JSON-об'єкт у рядку (JSON Lines).
+ * Аварійний дамп самописця (crash_flight_recorder.bin, див. Logger::writeCrashDump)
+ * має той самий формат і розкодовується так само.
+ */
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <unordered_map>
+#include "../BinaryLog.h"
+#include "../json.hpp"
+
+using namespace std;
+
+namespace {
+
+    string argText(const BinaryLog::Reader& reader, const LogArg& arg) {
+        if (arg.type == BinaryLog::ArgType::Str) return reader.stringAt((uint64_t)arg.value);
+        return to_string(arg.value);
+    }
+
+    string renderText(const BinaryLog::Reader& reader, const BinaryLog::Record& record,
+                      const unordered_map<string, string>& templates) {
+        if (record.tag == BinaryLog::TAG_TEXT) return record.text;
+
+        const string& key = reader.stringAt(record.messageId);
+        auto tpl = templates.find(key);
+        if (tpl != templates.end()) {
+            return BinaryLog::fillTemplate(tpl->second, record.args.size(),
+                                           [&](size_t n) { return argText(reader, record.args[n]); });
+        }
+        string text = key;
+        for (size_t i = 0; i < record.args.size(); ++i) {
+            text += (i == 0) ? ": " : ", ";
+            text += argText(reader, record.args[i]);
+        }
+        return text;
+    }
+
+    bool loadTemplates(const string& path, unordered_map<string, string>& templates) {
+        ifstream file(path);
+        if (!file.is_open()) return false;
+        try {
+            nlohmann::json translations = nlohmann::json::parse(file);
+            for (auto it = translations.begin(); it != translations.end(); ++it) {
+                if (it->is_string()) templates.emplace(it.key(), it->get<string>());
+            }
+        } catch (nlohmann::json::parse_error&) {
+            return false;
+        }
+        return true;
+    }
+}
+
+int main(int argc, char* argv[]) {
+    string inputPath;
+    string langPath;
+    bool json = false;
+
+    for (int i = 1; i < argc; ++i) {
+        string arg = argv[i];
+        if (arg == "--json") {
+            json = true;
+        } else if (arg == "--lang" && i + 1 < argc) {
+            langPath = argv[++i];
+        } else if (inputPath.empty()) {
+            inputPath = arg;
+        } else {
+            cerr << "Unexpected argument: " << arg << endl;
+            return 2;
+        }
+    }
+    if (inputPath.empty()) {
+        cerr << "Usage: logdecode <game_log.bin> [--json] [--lang <lang.json>]" << endl;
+        return 2;
+    }
+
+    ifstream input(inputPath, ios::binary);
+    if (!input.is_open()) {
+        cerr << "Cannot open " << inputPath << endl;
+        return 1;
+    }
+    string data((istreambuf_iterator<char>(input)), istreambuf_iterator<char>());
+
+    unordered_map<string, string> templates;
+    if (!langPath.empty() && !loadTemplates(langPath, templates)) {
+        cerr << "Cannot load language file " << langPath << endl;
+        return 1;
+    }
+
+    BinaryLog::Reader reader(data);
+    BinaryLog::Record record;
+    while (reader.next(record)) {
+        if (json) {
+            nlohmann::json line;
+            line["time_us"] = record.micros;
+            line["level"] = BinaryLog::levelName(record.level);
+            if (record.tag == BinaryLog::TAG_EVENT) {
+                line["event"] = reader.stringAt(record.messageId);
+                nlohmann::json args = nlohmann::json::array();
+                for (const LogArg& arg : record.args) {
+                    if (arg.type == BinaryLog::ArgType::Str) args.push_back(reader.stringAt((uint64_t)arg.value));
+                    else args.push_back(arg.value);
+                }
+                line["args"] = args;
+            }
+            line["text"] = renderText(reader, record, templates);
+            cout << line.dump() << '\n';
+        } else {
+            cout << "[" << BinaryLog::formatTime(record.micros) << "] [" << BinaryLog::levelName(record.level) << "] "
+                 << renderText(reader, record, templates) << '\n';
+        }
+    }
+
+    if (!reader.isValid()) {
+        cerr << "Log is truncated or corrupted; stopped at the last valid record." << endl;
+        return 1;
+    }
+    return 0;
+}
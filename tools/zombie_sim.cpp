@@ -0,0 +1,161 @@
+/**
+ * @file zombie_sim.cpp
+ * @brief Монте-Карло прогін балансу: тисячі ігор скриптованим гравцем на всіх ядрах.
+ * @details Використання:
+ *   zombie-sim [--games N] [--threads T] [--seed S] [--max-turns M]
+ *              [--sizes 15,25] [--walls 10,20,30] [--enemies 3,6] [--weapons 1,2] [--csv]
+ * Для кожної комбінації розміру карти, відсотка стін, кількості ворогів і стартової
+ * зброї (1 — меч, 2 — пістолет) грає N ігор і друкує частку перемог (серед усіх ігор
+ * і серед завершених, без нічиїх за лімітом ходів), кількість поразок і нічиїх та розподіли
+ * ходів, отриманої шкоди й очок (середнє, p10, p50, p90, максимум).
+ * Зерна ігор виводяться з --seed, тож прогін повторюваний за будь-якої кількості потоків.
+ */
+#include <iostream>
+#include <iomanip>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <chrono>
+#include <thread>
+#include "../SimBatch.h"
+
+using namespace std;
+
+namespace {
+
+    bool parseList(const string& text, vector<int>& values) {
+        values.clear();
+        stringstream stream(text);
+        string item;
+        while (getline(stream, item, ',')) {
+            try {
+                values.push_back(stoi(item));
+            } catch (const exception&) {
+                return false;
+            }
+        }
+        return !values.empty();
+    }
+
+    string weaponName(int weapon) { return weapon == 1 ? "Sword" : "Gun"; }
+
+    void printDistribution(const SimBatch::Distribution& d, bool csv) {
+        if (csv) {
+            cout << ',' << d.mean << ',' << d.p10 << ',' << d.p50 << ',' << d.p90 << ',' << d.max;
+        } else {
+            cout << "  " << setw(7) << d.mean << " [" << d.p10 << '/' << d.p50 << '/' << d.p90 << ' ' << d.max << ']';
+        }
+    }
+}
+
+int main(int argc, char* argv[]) {
+    size_t games = 1000;
+    unsigned threads = max(1u, thread::hardware_concurrency());
+    uint64_t seed = 1;
+    int maxTurns = 1000;
+    bool csv = false;
+    vector<int> sizes{15, 25, 40};
+    vector<int> walls{10, 20, 30};
+    vector<int> enemies{3, 6, 10};
+    vector<int> weapons{1, 2};
+
+    for (int i = 1; i < argc; ++i) {
+        string arg = argv[i];
+        bool hasValue = i + 1 < argc;
+        bool ok = true;
+        try {
+            if (arg == "--csv") csv = true;
+            else if (arg == "--games" && hasValue) games = stoull(argv[++i]);
+            else if (arg == "--threads" && hasValue) threads = max(1, stoi(argv[++i]));
+            else if (arg == "--seed" && hasValue) seed = stoull(argv[++i]);
+            else if (arg == "--max-turns" && hasValue) maxTurns = stoi(argv[++i]);
+            else if (arg == "--sizes" && hasValue) ok = parseList(argv[++i], sizes);
+            else if (arg == "--walls" && hasValue) ok = parseList(argv[++i], walls);
+            else if (arg == "--enemies" && hasValue) ok = parseList(argv[++i], enemies);
+            else if (arg == "--weapons" && hasValue) ok = parseList(argv[++i], weapons);
+            else ok = false;
+        } catch (const exception&) {
+            ok = false;
+        }
+        if (!ok) {
+            cerr << "Unexpected argument: " << arg << endl;
+            cerr << "Usage: zombie-sim [--games N] [--threads T] [--seed S] [--max-turns M]"
+                    " [--sizes a,b] [--walls a,b] [--enemies a,b] [--weapons 1,2] [--csv]" << endl;
+            return 2;
+        }
+    }
+    for (int size : sizes) {
+        if (size < 5) {
+            cerr << "Map size must be at least 5: " << size << endl;
+            return 2;
+        }
+    }
+
+    // Лог у консоль і файл з кількох потоків лише гальмує прогін
+    Logger::getInstance().setFormat(LogFormat::Off);
+    Logger::setLevel(LogLevel::Error);
+
+    // Усі комбінації параметрів; ігри однієї комбінації лежать поспіль
+    vector<SimConfig> configs;
+    for (int size : sizes) {
+        for (int wall : walls) {
+            for (int enemy : enemies) {
+                for (int weapon : weapons) {
+                    SimConfig config;
+                    config.mapWidth = size;
+                    config.mapHeight = size;
+                    config.wallPercent = wall;
+                    config.enemyCount = enemy;
+                    config.weapon = weapon;
+                    configs.push_back(config);
+                }
+            }
+        }
+    }
+
+    vector<SimBatch::Job> jobs;
+    jobs.reserve(configs.size() * games);
+    for (const SimConfig& config : configs) {
+        for (size_t g = 0; g < games; ++g) {
+            jobs.push_back({config, SimBatch::gameSeed(seed, g)});
+        }
+    }
+
+    auto start = chrono::steady_clock::now();
+    vector<SimBatch::GameResult> results = SimBatch::run(jobs, threads, maxTurns);
+    double seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+
+    cout << fixed << setprecision(1);
+    if (csv) {
+        cout << "size,walls,enemies,weapon,games,win_pct,decided_win_pct,defeats,timeouts";
+        for (const char* name : {"turns", "damage", "score"}) {
+            cout << ',' << name << "_mean," << name << "_p10," << name << "_p50," << name << "_p90," << name << "_max";
+        }
+        cout << '\n';
+    } else {
+        cout << "size walls enemies weapon   win%  dec.win%  defeats  timeouts   turns mean [p10/p50/p90 max]"
+                "   damage mean [p10/p50/p90 max]   score mean [p10/p50/p90 max]\n";
+    }
+
+    for (size_t c = 0; c < configs.size(); ++c) {
+        const SimConfig& config = configs[c];
+        SimBatch::Summary s = SimBatch::summarize(results, c * games, (c + 1) * games);
+        if (csv) {
+            cout << config.mapWidth << ',' << config.wallPercent << ',' << config.enemyCount << ','
+                 << weaponName(config.weapon) << ',' << s.games << ',' << 100.0 * s.winRate() << ','
+                 << 100.0 * s.decidedWinRate() << ',' << s.defeats << ',' << s.timeouts;
+        } else {
+            cout << setw(4) << config.mapWidth << setw(6) << config.wallPercent << setw(8) << config.enemyCount
+                 << setw(7) << weaponName(config.weapon) << setw(7) << 100.0 * s.winRate()
+                 << setw(10) << 100.0 * s.decidedWinRate() << setw(9) << s.defeats << setw(10) << s.timeouts;
+        }
+        printDistribution(s.turns, csv);
+        printDistribution(s.damageTaken, csv);
+        printDistribution(s.score, csv);
+        cout << '\n';
+    }
+
+    cerr << jobs.size() << " games on " << threads << " threads in " << seconds << " s ("
+         << (seconds > 0 ? (double)jobs.size() / seconds : 0.0) << " games/s)" << endl;
+    return 0;
+}